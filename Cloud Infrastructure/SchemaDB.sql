@@ -89,4 +89,26 @@ CREATE TABLE IF NOT EXISTS status (
     value INT NOT NULL
 );
 
+-- end-to-end alarm latency reported by the vents: status change (seq) to actuation, ms
+CREATE TABLE IF NOT EXISTS latency (
+    id INT AUTO_INCREMENT PRIMARY KEY,
+    time BIGINT NOT NULL,
+    timestamp TIMESTAMP NOT NULL,
+    device INT NOT NULL,
+    seq INT NOT NULL,
+    value INT NOT NULL
+);
 
+-- hot path stage timing scraped from the detectors' /metrics: per stage counters since boot
+CREATE TABLE IF NOT EXISTS metrics (
+    id INT AUTO_INCREMENT PRIMARY KEY,
+    time BIGINT NOT NULL,
+    timestamp TIMESTAMP NOT NULL,
+    device INT NOT NULL,
+    stage VARCHAR(16) NOT NULL,
+    calls BIGINT NOT NULL,
+    min_time BIGINT NOT NULL,
+    avg_time BIGINT NOT NULL,
+    max_time BIGINT NOT NULL,
+    unit VARCHAR(16) NOT NULL
+);
@@ -7,6 +7,14 @@ import pymysql
 from coapthon.client.helperclient import HelperClient
 
 
+# CoAP content-format numbers
+SENML_JSON_CONTENT_FORMAT = 50   # application/json (SenML JSON, "e" array layout)
+SENML_CBOR_CONTENT_FORMAT = 112  # application/senml+cbor (RFC 8428)
+
+# SenML-CBOR integer labels (RFC 8428, Table 4)
+SENML_CBOR_LABELS = {-2: "bn", -3: "bt", -4: "bu", -1: "bver", 0: "n", 1: "u", 2: "v", 6: "t"}
+
+
 # ==================== Load configuration file info ====================
 def load_db_config(config_path="config.xml"):
     tree = ET.parse(config_path)
@@ -28,6 +36,12 @@ def load_cooja_mode(config_path="config.xml"):
     cooja_mode = root.get("cooja", "0") == "1"
     return cooja_mode
 
+def load_senml_format(config_path="config.xml"):
+    tree = ET.parse(config_path)
+    root = tree.getroot()
+    senml_format = root.get("senml", "json")
+    return SENML_CBOR_CONTENT_FORMAT if senml_format == "cbor" else SENML_JSON_CONTENT_FORMAT
+
 def load_devices(config_path="config.xml"):
     tree = ET.parse(config_path)
     root = tree.getroot()
@@ -101,53 +115,105 @@ def insert_measurement(cursor, table, base_time, time_offset, max_offset, device
     cursor.execute(query, (measurement_time, timestamp_value, device_id, value))
 
 
-def parse_and_store(payload, cursor):
+def senml_pack_to_json_layouts(pack, labels=None):
+    # Split a RFC 8428 SenML pack [{bn, bt, bu, v, t}, {v, t}, ..., {bn, bu, v, t}, ...] (CBOR records
+    # keyed by integer labels when 'labels' is given) into one {"bn", "bt", "bu", "e": [...]} layout,
+    # as the json payloads, per base name. Base fields apply to all the following records.
+    if not isinstance(pack, list) or not pack:
+        return []
+    layouts = []
+    base = {}
+    current = None
+    for record in pack:
+        if labels:
+            record = {labels.get(k, k): v for k, v in record.items()}
+        for key in ("bn", "bt", "bu"):
+            if key in record:
+                base[key] = record[key]
+        if current is None or current.get("bn") != base.get("bn"):
+            current = {key: base[key] for key in ("bn", "bt", "bu") if key in base}
+            current["e"] = []
+            layouts.append(current)
+        current["e"].append({key: record[key] for key in ("v", "t") if key in record})
+    return layouts
+
+
+def decode_senml(payload, content_format):
+    # list of {"bn", "bt", "bu", "e": [...]} layouts carried by the payload
+    if content_format == SENML_CBOR_CONTENT_FORMAT:
+        if isinstance(payload, str):
+            payload = payload.encode('latin-1')  # raw bytes decoded as text by the CoAP client
+        import cbor2  # needed only with senml="cbor" in config.xml
+        return senml_pack_to_json_layouts(cbor2.loads(payload), SENML_CBOR_LABELS)
+
+    if isinstance(payload, bytes):
+        payload = payload.decode('utf-8')
+    data = json.loads(payload)
+    if isinstance(data, list):
+        return senml_pack_to_json_layouts(data)  # multi-series pack (/all)
+    return [data]
+
+
+def parse_and_store(payload, cursor, content_format=SENML_JSON_CONTENT_FORMAT):
     try:
-        if isinstance(payload, bytes):
-            payload = payload.decode('utf-8')
+        layouts = decode_senml(payload, content_format)
+        if not layouts:
+            print("Empty SenML payload")
+        for data in layouts:
+            store_series(data, cursor)
 
-        data = json.loads(payload)
-        uri = data.get("bn")
-        if uri is None:
-            print("Missing base URI (bn) in payload")
-            return
+    except Exception as e:
+        print("Error parsing/storing SenML:", e)
 
-        table = uri.rstrip('/').split('/')[-1]  # e.g., "temp" or "status"
-        base_uri = "/".join(uri.rstrip('/').split('/')[:-1])  # e.g., "coap://[fd00::202:2:2:2]"
 
-        device_id = get_device_id(base_uri)
-        if device_id is None:
-            print(f"Unknown base URI: {base_uri}")
-            return
+def store_series(data, cursor):
+    uri = data.get("bn")
+    if uri is None:
+        print("Missing base URI (bn) in payload")
+        return
 
-        bt = int(data.get("bt", 0))
+    table = uri.rstrip('/').split('/')[-1]  # e.g., "temp" or "status"
+    base_uri = "/".join(uri.rstrip('/').split('/')[:-1])  # e.g., "coap://[fd00::202:2:2:2]"
 
-        if table == "status":
-            status_value = data.get("status")
-            if status_value is not None:
-                insert_measurement(cursor, "status", bt, 0, 0, device_id, status_value)
-            else:
-                print("Missing 'status' field in status payload.")
-            return  # Exit early for status payload
+    device_id = get_device_id(base_uri)
+    if device_id is None:
+        print(f"Unknown base URI: {base_uri}")
+        return
 
-        entries = data.get("e", [])
-        if not isinstance(entries, list) or not entries:
-            print("No measurement entries found.")
-            return
-        
-        max_offset = max(int(entry.get("t", 0)) for entry in entries)
-        for entry in entries:
-            t = int(entry.get("t", 0))
-            v = entry.get("v")
-            v = entry.get("v")
-            if v is not None:
-                # Apply scaling only for specific tables
-                if table in ("temp", "hum", "pressure"):
-                    v = v / 100.0
-                insert_measurement(cursor, table, bt, t, max_offset, device_id, v)
+    bt = int(data.get("bt", 0))
 
-    except Exception as e:
-        print("Error parsing/storing SenML:", e)
+    if table == "status":
+        status_value = data.get("status")
+        if status_value is not None:
+            insert_measurement(cursor, "status", bt, 0, 0, device_id, status_value)
+        else:
+            print("Missing 'status' field in status payload.")
+        return  # Exit early for status payload
+
+    if table == "latency":
+        # vent alarm latency: last status change actuated (seq) and its delay (v, ms)
+        if int(data.get("n", 0)) > 0 and data.get("v") is not None:
+            cursor.execute("""
+                INSERT INTO latency (time, timestamp, device, seq, value)
+                VALUES (%s, %s, %s, %s, %s)
+            """, (bt, datetime.now(), device_id, int(data.get("seq", 0)), int(data["v"])))
+            print(f"Alarm latency: {data['v']} ms (p50 {data.get('p50')} ms, p99 {data.get('p99')} ms, lost {data.get('lost')})")
+        return
+
+    entries = data.get("e", [])
+    if not isinstance(entries, list) or not entries:
+        print("No measurement entries found.")
+        return
+
+    max_offset = max(int(entry.get("t", 0)) for entry in entries)
+    for entry in entries:
+        t = int(entry.get("t", 0))
+        v = entry.get("v")
+        if v is not None:
+            # Apply scaling only for specific tables
+            if table in ("temp", "hum", "pressure"):
+                v = v / 100.0
+            insert_measurement(cursor, table, bt, t, max_offset, device_id, v)
 
 
 # ==================== CoAP Observation Threads ====================
@@ -157,7 +223,7 @@ def make_on_response(conn):
             try:
                 with conn.cursor() as cursor:
                     response.pretty_print()
-                    parse_and_store(response.payload, cursor)
+                    parse_and_store(response.payload, cursor, response.content_type)
                 conn.commit()
             except Exception as e:
                 print("Database error:", e)
@@ -166,7 +232,7 @@ def make_on_response(conn):
     return on_response
     
 
-def observe_resource(address, port, resource, stop_event):
+def observe_resource(address, port, resource, stop_event, content_format=SENML_JSON_CONTENT_FORMAT):
     try:
         # Persistent DB connection for this observer
         conn = pymysql.connect(
@@ -180,7 +246,9 @@ def observe_resource(address, port, resource, stop_event):
 	
         client = HelperClient(server=(address, port))
         print(f"Observing coap://[{address}]:{port}/{resource}")
-        client.observe(resource, make_on_response(conn))
+        if resource in ("status", "latency"):
+            content_format = SENML_JSON_CONTENT_FORMAT  # status and latency are served as json only
+        client.observe(resource, make_on_response(conn), accept=content_format)
 
         # Stay alive while stop_event is not set
         while not stop_event.is_set():
@@ -207,8 +275,70 @@ def observe_resource(address, port, resource, stop_event):
                 print(f"Error closing DB connection: {e}")
 
 
-def observer_thread(address, port, resource, stop_event):
-    observe_resource(address, port, resource, stop_event)
+def observer_thread(address, port, resource, stop_event, content_format):
+    observe_resource(address, port, resource, stop_event, content_format)
+
+
+# ==================== Metrics Scrape Thread ====================
+METRICS_SCRAPE_PERIOD = 60  # sec
+
+def store_metrics(data, cursor):
+    # /metrics: {"bn", "uptime", "st": {"u", "hz", "it", <stage>: [calls, min, avg, max], ...}}
+    uri = data.get("bn", "")
+    device_id = get_device_id("/".join(uri.rstrip('/').split('/')[:-1]))
+    if device_id is None:
+        print(f"Unknown base URI: {uri}")
+        return
+    stages = data.get("st", {})
+    unit = stages.get("u", "")
+    uptime = int(data.get("uptime", 0))
+    for stage, values in stages.items():
+        if not isinstance(values, list) or len(values) != 4:
+            continue  # u, hz, it
+        calls, min_time, avg_time, max_time = values
+        cursor.execute("""
+            INSERT INTO metrics (time, timestamp, device, stage, calls, min_time, avg_time, max_time, unit)
+            VALUES (%s, %s, %s, %s, %s, %s, %s, %s, %s)
+        """, (uptime, datetime.now(), device_id, stage, calls, min_time, avg_time, max_time, unit))
+
+
+def metrics_thread(address, port, stop_event):
+    conn = None
+    client = None
+    try:
+        conn = pymysql.connect(
+            host=db_config['host'],
+            user=db_config['user'],
+            password=db_config['password'],
+            database=db_config['database'],
+            port=db_config['port'],
+            autocommit=False
+        )
+        client = HelperClient(server=(address, port))
+        print(f"Scraping coap://[{address}]:{port}/metrics every {METRICS_SCRAPE_PERIOD} s")
+        while not stop_event.is_set():
+            response = client.get("metrics", timeout=10)
+            if response and response.payload:
+                try:
+                    with conn.cursor() as cursor:
+                        store_metrics(json.loads(response.payload), cursor)
+                    conn.commit()
+                except Exception as e:
+                    print("Error parsing/storing metrics:", e)
+            stop_event.wait(METRICS_SCRAPE_PERIOD)
+    except Exception as e:
+        print(f"Metrics scrape failed at {address}:{port}:", e)
+    finally:
+        if client:
+            try:
+                client.stop()
+            except Exception as e:
+                print(f"Error stopping CoAP client: {e}")
+        if conn:
+            try:
+                conn.close()
+            except Exception as e:
+                print(f"Error closing DB connection: {e}")
 
 
 
@@ -228,6 +358,7 @@ def main():
     devices = load_devices("config.xml")
     
     is_cooja_mode = load_cooja_mode("config.xml")
+    senml_format = load_senml_format("config.xml")
     
     devices_cache = {}
     for device in devices:
@@ -281,17 +412,42 @@ def main():
     
     
     for device in [d for d in devices if d.get('cat') == "SSD"]:
-        resources_list = device['resources'] if is_cooja_mode else ["temp", "pm1_0", "status"]
+        if "all" in device['resources']:
+            # one subscription for all the sensor series (SenML pack) plus the status
+            resources_list = ["all", "status"]
+        else:
+            resources_list = device['resources'] if is_cooja_mode else ["temp", "pm1_0", "status"]
+            resources_list = [r for r in resources_list if r != "metrics"]  # scraped, not observed
         for resource in resources_list:
             thread = threading.Thread(
                 target=observer_thread,
-                args=(device['address'], device['port'], resource, stop_event),
+                args=(device['address'], device['port'], resource, stop_event, senml_format),
                 daemon=False  # threads closed manually
             )
             thread.start()
             threads.append(thread)
             time.sleep(1)  # slight delay to stagger observations
 
+    # hot path stage timing of the SSDs, scraped periodically
+    for device in [d for d in devices if d.get('cat') == "SSD" and "metrics" in d['resources']]:
+        thread = threading.Thread(
+            target=metrics_thread,
+            args=(device['address'], device['port'], stop_event),
+            daemon=False  # threads closed manually
+        )
+        thread.start()
+        threads.append(thread)
+
+    # alarm latency measured by the vents (status change on the SSD to vent actuation)
+    for device in [d for d in devices if d.get('cat') == "SV" and "latency" in d['resources']]:
+        thread = threading.Thread(
+            target=observer_thread,
+            args=(device['address'], device['port'], "latency", stop_event, senml_format),
+            daemon=False  # threads closed manually
+        )
+        thread.start()
+        threads.append(thread)
+
     try:
         print("\nType 'server stop' to shut down the server.")
         while True:
@@ -83,7 +83,7 @@ def is_safe_integer(input_str: str) -> bool:
 
 def query_sensor(sensor: str, n: str | None):
     print("----------------------------")
-    allowed_sensors = { "temp", "hum", "pressure", "tvoc", "raw_h2", "raw_ethanol", "pm1_0", "pm2_5", "nc0_5", "status" }
+    allowed_sensors = { "temp", "hum", "pressure", "tvoc", "raw_h2", "raw_ethanol", "pm1_0", "pm2_5", "nc0_5", "status", "latency" }
     if not is_safe_param(sensor, allowed_sensors):
         return
     n_measurements = int(n) if n and is_safe_integer(n) else 10 # Default if not provided
@@ -211,6 +211,251 @@ def dev_sensor(sensor: str, n: str | None):
     print("----------------------------")
 
 
+def get_dev_stats(device, sensor: str):
+    # running statistics since boot computed on the device (?stats), None if not available
+    address = device["address"]
+    port = device["port"]
+    path = f"/{sensor}?stats"
+    client = None
+    try:
+        client = HelperClient(server=(address, port))
+        response = client.get(path)
+        if response and response.payload:
+            return json.loads(response.payload)
+    except Exception as e:
+        print(f"[Error] Failed to query '{sensor}' stats: {e}")
+    finally:
+        try:
+            client.stop()
+        except:
+            pass
+    return None
+
+def dev_stats(sensor: str):
+    print("----------------------------")
+    allowed_sensors = {"temp", "hum", "pressure", "tvoc", "raw_h2", "raw_ethanol", "pm1_0", "pm2_5", "nc0_5"}
+    if not is_safe_param(sensor, allowed_sensors):
+        return
+    device = get_dev_by_cat("SSD")
+    if not device:
+        print("[Error] No SSD device found.")
+        return
+
+    stats = get_dev_stats(device, sensor)
+    if stats is None:
+        print("[No Response]")
+    elif stats.get("n", 0) == 0:
+        print(f"No measurements of '{sensor}' on the device yet.")
+    else:
+        # temp, hum and pressure are sent scaled by 100
+        scale = 100.0 if sensor in ("temp", "hum", "pressure") else 1.0
+        print(f"'{sensor}' statistics since device boot ({stats['n']} measurements):")
+        print(f"   mean: {stats['mean'] / scale:.2f} {stats.get('bu', '')}")
+        print(f"   std dev: {(stats['var'] ** 0.5) / scale:.2f}")
+        print(f"   min: {stats['min'] / scale} | max: {stats['max'] / scale}")
+    print("----------------------------")
+
+def dev_hazard_levels():
+    print("----------------------------")
+    hazard_sensors = ["pm1_0", "pm2_5", "nc0_5"]
+    device = get_dev_by_cat("SSD")
+    if not device:
+        print("[Error] No SSD device found.")
+        return
+    print("Average hazard parameter values since device boot:")
+    for sensor in hazard_sensors:
+        stats = get_dev_stats(device, sensor)
+        if stats and stats.get("n", 0) > 0:
+            print(f"   '{sensor}': {stats['mean']:.2f} (max {stats['max']})")
+        else:
+            print(f"No data available for '{sensor}'.")
+    print("----------------------------")
+
+def dev_sensing(min_str: str | None = None, max_str: str | None = None):
+    # adaptive sensing period of the SSD: GET, or POST of new bounds (seconds)
+    print("----------------------------")
+    if min_str is not None and not (is_safe_integer(min_str) and is_safe_integer(max_str)):
+        print("[Invalid Command] Usage: set sensing <min> <max>")
+        return
+    device = get_dev_by_cat("SSD")
+    if not device:
+        print("[Error] No SSD device found.")
+        return
+
+    # CoAP request
+    address = device["address"]
+    port = device["port"]
+    path = "/sensing"
+    client = None
+    try:
+        client = HelperClient(server=(address, port))
+        if min_str is not None:
+            response = client.post(path, f"min={min_str}&max={max_str}")
+            if response:
+                print(f"CoAP POST to coap://[{address}]:{port}{path}: {response.code}")
+            else:
+                print("[No Response] Sensing bounds update not confirmed.")
+        response = client.get(path)
+        if response and response.payload:
+            sensing = json.loads(response.payload)
+            print(f"Sensing period: {sensing['period']} s (bounds {sensing['min']}-{sensing['max']} s)")
+            print(f"   samples since boot: {sensing['samples']} in {sensing['uptime']} s")
+            print(f"   back to the minimum period: {sensing['shortened']} times")
+            if sensing["latency"]:
+                print(f"   last fire detection latency: {sensing['latency']} s")
+        else:
+            print("[No Response]")
+    except Exception as e:
+        print(f"[Error] Failed to query sensing period: {e}")
+    finally:
+        try:
+            client.stop()
+        except:
+            pass
+    print("----------------------------")
+
+
+def dev_notifications():
+    # notification limiter counters of the SSD
+    print("----------------------------")
+    device = get_dev_by_cat("SSD")
+    if not device:
+        print("[Error] No SSD device found.")
+        return
+
+    # CoAP request
+    address = device["address"]
+    port = device["port"]
+    path = "/notifications"
+    client = None
+    try:
+        client = HelperClient(server=(address, port))
+        response = client.get(path)
+        if response and response.payload:
+            counters = json.loads(response.payload)
+            print(f"Notifications (min gap {counters['gap']} ms per resource):")
+            print(f"   requested: {counters['requested']}, sent: {counters['sent']}")
+            print(f"   delayed: {counters['delayed']}, coalesced: {counters['coalesced']}")
+            print(f"   status (never limited): {counters['bypassed']}")
+        else:
+            print("[No Response]")
+    except Exception as e:
+        print(f"[Error] Failed to query notification counters: {e}")
+    finally:
+        try:
+            client.stop()
+        except:
+            pass
+    print("----------------------------")
+
+
+def dev_observers():
+    # observer pool counters of the SSD
+    print("----------------------------")
+    device = get_dev_by_cat("SSD")
+    if not device:
+        print("[Error] No SSD device found.")
+        return
+
+    # CoAP request
+    address = device["address"]
+    port = device["port"]
+    path = "/observers"
+    client = None
+    try:
+        client = HelperClient(server=(address, port))
+        response = client.get(path)
+        if response and response.payload:
+            pool = json.loads(response.payload)
+            print(f"Observers: {pool['used']}/{pool['pool']} ({pool['pinned']} on status, peak {pool['peak']})")
+            print(f"   registrations: {pool['registrations']}")
+            print(f"   evicted: {pool['evicted']}, rejected: {pool['rejected']}")
+        else:
+            print("[No Response]")
+    except Exception as e:
+        print(f"[Error] Failed to query observer pool: {e}")
+    finally:
+        try:
+            client.stop()
+        except:
+            pass
+    print("----------------------------")
+
+
+def dev_energy():
+    # energy accounting (Energest) of the last report window, SSD and SV
+    print("----------------------------")
+    for cat in ("SSD", "SV"):
+        device = get_dev_by_cat(cat)
+        if not device:
+            print(f"[Error] No {cat} device found.")
+            continue
+
+        # CoAP request
+        address = device["address"]
+        port = device["port"]
+        path = "/energy"
+        client = None
+        try:
+            client = HelperClient(server=(address, port))
+            response = client.get(path)
+            if response and response.payload:
+                en = json.loads(response.payload)
+                period = f", sensing period {en['period']} s" if "period" in en else ""
+                print(f"{cat} energy over the last {en['w'] / 1000:.0f} s window (report {en['n']}{period}):")
+                print(f"   {en['uA']} uA average, {en['mAh_day']} mAh/day")
+                print(f"   cpu: {en['cpu']} ms, lpm: {en['lpm']} ms, deep lpm: {en['dlpm']} ms")
+                print(f"   radio tx: {en['tx']} ms, rx: {en['rx']} ms")
+                apps = [k for k in ("sensing", "inference", "encoding", "notify", "actuation") if k in en]
+                if apps:
+                    print("   " + ", ".join(f"{k}: {en[k]} ms" for k in apps))
+            else:
+                print("[No Response]")
+        except Exception as e:
+            print(f"[Error] Failed to query {cat} energy: {e}")
+        finally:
+            try:
+                client.stop()
+            except:
+                pass
+    print("----------------------------")
+
+
+def dev_latency():
+    # end-to-end alarm latency measured by the SV (status change on the SSD to vent actuation)
+    print("----------------------------")
+    device = get_dev_by_cat("SV")
+    if not device:
+        print("[Error] No SV device found.")
+        return
+
+    # CoAP request
+    address = device["address"]
+    port = device["port"]
+    path = "/latency"
+    client = None
+    try:
+        client = HelperClient(server=(address, port))
+        response = client.get(path)
+        if response and response.payload:
+            lat = json.loads(response.payload)
+            print(f"Alarm latency over {lat['n']} status changes (clock sync rtt {lat['rtt']} ms):")
+            print(f"   last: {lat['v']} ms (seq {lat['seq']}), lost: {lat['lost']}")
+            print(f"   min: {lat['min']} ms, avg: {lat['avg']} ms, max: {lat['max']} ms")
+            print(f"   p50: <= {lat['p50']} ms, p99: <= {lat['p99']} ms")
+            print(f"   histogram: {lat['hist']}")
+        else:
+            print("[No Response]")
+    except Exception as e:
+        print(f"[Error] Failed to query alarm latency: {e}")
+    finally:
+        try:
+            client.stop()
+        except:
+            pass
+    print("----------------------------")
+
+
 def set_safety(param: str, val_str: str | None):
     print("----------------------------")
     allowed_params = set(safety_levels_default.keys())
@@ -246,6 +491,47 @@ def set_safety(param: str, val_str: str | None):
         except:
             pass
     print("----------------------------")
+
+def set_notify(sensor: str, deadband: str, max_interval: str | None):
+    # notification policy of a SSD sensor resource: deadband in payload units (temp, hum,
+    # pressure * 100), "cycle" for the buffer cycle policy, max interval in seconds
+    print("----------------------------")
+    allowed_sensors = {"temp", "hum", "pressure", "tvoc", "raw_h2", "raw_ethanol", "pm1_0", "pm2_5", "nc0_5"}
+    if not is_safe_param(sensor, allowed_sensors):
+        return
+    if deadband != "cycle" and not is_safe_integer(deadband):
+        return
+    if max_interval is not None and not is_safe_integer(max_interval):
+        return
+    device = get_dev_by_cat("SSD")
+    if not device:
+        print("[Error] No SSD device found.")
+        return
+
+    # CoAP request
+    address = device["address"]
+    port = device["port"]
+    path = f"/{sensor}"
+    payload = "deadband=" + ("-1" if deadband == "cycle" else deadband)
+    if max_interval is not None:
+        payload += f"&max_interval={max_interval}"
+    client = None
+    try:
+        client = HelperClient(server=(address, port))
+        response = client.post(path, payload)
+        if response:
+            print(f"CoAP POST to coap://[{address}]:{port}{path} successful:")
+            print(response.pretty_print())
+        else:
+            print("[No Response] Notification policy update not confirmed.")
+    except Exception as e:
+        print(f"[Error] CoAP POST failed: {e}")
+    finally:
+        try:
+            client.stop()
+        except:
+            pass
+    print("----------------------------")
     
 def start_stop_vent(action: str, vent_type: str):
     print("----------------------------")
@@ -373,8 +659,18 @@ Commands:
   query status (<n>)           - Query DB last 'n' status records
   dev <sensor> (<n>)           - Query dev last 'n' sensor measurements
   dev status                   - Query dev current environment status
+  dev stats <sensor>           - Query dev sensor statistics since boot
+  dev hazard levels            - Show the device average of hazard parameters
+  dev sensing                  - Show the dev adaptive sensing period
+  dev notifications            - Show the dev notification limiter counters
+  dev observers                - Show the dev observer pool counters
+  dev latency                  - Show the vent alarm latency (status change to actuation)
+  dev energy                   - Show the SSD and SV energy per subsystem (last report window)
   daily hazard levels          - Show the daily average of hazard parameters
   set safety <param> (<value>) - Set levels by given (or default) parameters
+  set sensing <min> <max>      - Set the dev sensing period bounds (sec)
+  set notify <sensor> <deadband|cycle> (<max interval>)
+                               - Set the dev notification policy of a sensor
   start <filter|smoke> vent    - Start ventilation
   stop  <filter|smoke> vent    - Stop ventilation
   exit                         - Exit the server
@@ -408,10 +704,28 @@ if __name__ == "__main__":
                 query_sensor(parts[1], parts[2] if len(parts) == 3 else None)
             elif cmd.startswith("dev status"):
                 dev_status()
+            elif cmd.startswith("dev stats ") and len(parts) == 3:
+                dev_stats(parts[2])
+            elif cmd == "dev hazard levels":
+                dev_hazard_levels()
+            elif cmd == "dev sensing":
+                dev_sensing()
+            elif cmd == "dev notifications":
+                dev_notifications()
+            elif cmd == "dev observers":
+                dev_observers()
+            elif cmd == "dev latency":
+                dev_latency()
+            elif cmd == "dev energy":
+                dev_energy()
             elif cmd.startswith("dev ") and len(parts) <= 3:
                 dev_sensor(parts[1], parts[2] if len(parts) == 3 else None)
             elif cmd == "daily hazard levels":
                 daily_hazard_levels()
+            elif cmd.startswith("set notify ") and (len(parts) == 4 or len(parts) == 5):
+                set_notify(parts[2], parts[3], parts[4] if len(parts) == 5 else None)
+            elif cmd.startswith("set sensing ") and len(parts) == 4:
+                dev_sensing(parts[2], parts[3])
             elif cmd.startswith("set safety ") and (len(parts) == 3 or len(parts) == 4):
                 set_safety(parts[2], parts[3] if len(parts) == 4 else None)
             elif (cmd.startswith("start ") or cmd.startswith("stop ")) and len(parts) == 3:
@@ -0,0 +1,275 @@
+<?xml version="1.0" encoding="UTF-8"?>
+<simconf version="2023090101">
+  <simulation>
+    <title>iot_project_adaptive_sensing_sim</title>
+    <speedlimit>1.0</speedlimit>
+    <randomseed>123456</randomseed>
+    <motedelay_us>1000000</motedelay_us>
+    <radiomedium>
+      org.contikios.cooja.radiomediums.UDGM
+      <transmitting_range>50.0</transmitting_range>
+      <interference_range>100.0</interference_range>
+      <success_ratio_tx>1.0</success_ratio_tx>
+      <success_ratio_rx>1.0</success_ratio_rx>
+    </radiomedium>
+    <events>
+      <logoutput>40000</logoutput>
+    </events>
+    <motetype>
+      org.contikios.cooja.contikimote.ContikiMoteType
+      <description>border router</description>
+      <source>[CONFIG_DIR]/border_router/border_router.c</source>
+      <commands>$(MAKE) -j$(CPUS) border_router.cooja TARGET=cooja</commands>
+      <moteinterface>org.contikios.cooja.interfaces.Position</moteinterface>
+      <moteinterface>org.contikios.cooja.interfaces.Battery</moteinterface>
+      <moteinterface>org.contikios.cooja.contikimote.interfaces.ContikiVib</moteinterface>
+      <moteinterface>org.contikios.cooja.contikimote.interfaces.ContikiMoteID</moteinterface>
+      <moteinterface>org.contikios.cooja.contikimote.interfaces.ContikiRS232</moteinterface>
+      <moteinterface>org.contikios.cooja.contikimote.interfaces.ContikiBeeper</moteinterface>
+      <moteinterface>org.contikios.cooja.interfaces.IPAddress</moteinterface>
+      <moteinterface>org.contikios.cooja.contikimote.interfaces.ContikiRadio</moteinterface>
+      <moteinterface>org.contikios.cooja.contikimote.interfaces.ContikiButton</moteinterface>
+      <moteinterface>org.contikios.cooja.contikimote.interfaces.ContikiPIR</moteinterface>
+      <moteinterface>org.contikios.cooja.contikimote.interfaces.ContikiClock</moteinterface>
+      <moteinterface>org.contikios.cooja.contikimote.interfaces.ContikiLED</moteinterface>
+      <moteinterface>org.contikios.cooja.contikimote.interfaces.ContikiCFS</moteinterface>
+      <moteinterface>org.contikios.cooja.contikimote.interfaces.ContikiEEPROM</moteinterface>
+      <moteinterface>org.contikios.cooja.interfaces.Mote2MoteRelations</moteinterface>
+      <moteinterface>org.contikios.cooja.interfaces.MoteAttributes</moteinterface>
+      <mote>
+        <interface_config>
+          org.contikios.cooja.interfaces.Position
+          <pos x="40.43316703967962" y="1.9285407914673924" />
+        </interface_config>
+        <interface_config>
+          org.contikios.cooja.contikimote.interfaces.ContikiMoteID
+          <id>1</id>
+        </interface_config>
+      </mote>
+    </motetype>
+    <motetype>
+      org.contikios.cooja.contikimote.ContikiMoteType
+      <description>smart smoke detector</description>
+      <source>[CONFIG_DIR]/smart_smoke_detector/smart_smoke_detector.c</source>
+      <commands>$(MAKE) -j$(CPUS) smart_smoke_detector.cooja TARGET=cooja</commands>
+      <moteinterface>org.contikios.cooja.interfaces.Position</moteinterface>
+      <moteinterface>org.contikios.cooja.interfaces.Battery</moteinterface>
+      <moteinterface>org.contikios.cooja.contikimote.interfaces.ContikiVib</moteinterface>
+      <moteinterface>org.contikios.cooja.contikimote.interfaces.ContikiMoteID</moteinterface>
+      <moteinterface>org.contikios.cooja.contikimote.interfaces.ContikiRS232</moteinterface>
+      <moteinterface>org.contikios.cooja.contikimote.interfaces.ContikiBeeper</moteinterface>
+      <moteinterface>org.contikios.cooja.interfaces.IPAddress</moteinterface>
+      <moteinterface>org.contikios.cooja.contikimote.interfaces.ContikiRadio</moteinterface>
+      <moteinterface>org.contikios.cooja.contikimote.interfaces.ContikiButton</moteinterface>
+      <moteinterface>org.contikios.cooja.contikimote.interfaces.ContikiPIR</moteinterface>
+      <moteinterface>org.contikios.cooja.contikimote.interfaces.ContikiClock</moteinterface>
+      <moteinterface>org.contikios.cooja.contikimote.interfaces.ContikiLED</moteinterface>
+      <moteinterface>org.contikios.cooja.contikimote.interfaces.ContikiCFS</moteinterface>
+      <moteinterface>org.contikios.cooja.contikimote.interfaces.ContikiEEPROM</moteinterface>
+      <moteinterface>org.contikios.cooja.interfaces.Mote2MoteRelations</moteinterface>
+      <moteinterface>org.contikios.cooja.interfaces.MoteAttributes</moteinterface>
+      <mote>
+        <interface_config>
+          org.contikios.cooja.interfaces.Position
+          <pos x="55.97825373761299" y="23.20375282708021" />
+        </interface_config>
+        <interface_config>
+          org.contikios.cooja.contikimote.interfaces.ContikiMoteID
+          <id>2</id>
+        </interface_config>
+      </mote>
+    </motetype>
+    <motetype>
+      org.contikios.cooja.contikimote.ContikiMoteType
+      <description>Cooja Mote Type #3</description>
+      <source>[CONFIG_DIR]/smart_vent/smart_vent.c</source>
+      <commands>$(MAKE) -j$(CPUS) smart_vent.cooja TARGET=cooja</commands>
+      <moteinterface>org.contikios.cooja.interfaces.Position</moteinterface>
+      <moteinterface>org.contikios.cooja.interfaces.Battery</moteinterface>
+      <moteinterface>org.contikios.cooja.contikimote.interfaces.ContikiVib</moteinterface>
+      <moteinterface>org.contikios.cooja.contikimote.interfaces.ContikiMoteID</moteinterface>
+      <moteinterface>org.contikios.cooja.contikimote.interfaces.ContikiRS232</moteinterface>
+      <moteinterface>org.contikios.cooja.contikimote.interfaces.ContikiBeeper</moteinterface>
+      <moteinterface>org.contikios.cooja.interfaces.IPAddress</moteinterface>
+      <moteinterface>org.contikios.cooja.contikimote.interfaces.ContikiRadio</moteinterface>
+      <moteinterface>org.contikios.cooja.contikimote.interfaces.ContikiButton</moteinterface>
+      <moteinterface>org.contikios.cooja.contikimote.interfaces.ContikiPIR</moteinterface>
+      <moteinterface>org.contikios.cooja.contikimote.interfaces.ContikiClock</moteinterface>
+      <moteinterface>org.contikios.cooja.contikimote.interfaces.ContikiLED</moteinterface>
+      <moteinterface>org.contikios.cooja.contikimote.interfaces.ContikiCFS</moteinterface>
+      <moteinterface>org.contikios.cooja.contikimote.interfaces.ContikiEEPROM</moteinterface>
+      <moteinterface>org.contikios.cooja.interfaces.Mote2MoteRelations</moteinterface>
+      <moteinterface>org.contikios.cooja.interfaces.MoteAttributes</moteinterface>
+      <mote>
+        <interface_config>
+          org.contikios.cooja.interfaces.Position
+          <pos x="28.237233185476335" y="24.857537038189186" />
+        </interface_config>
+        <interface_config>
+          org.contikios.cooja.contikimote.interfaces.ContikiMoteID
+          <id>3</id>
+        </interface_config>
+      </mote>
+    </motetype>
+  </simulation>
+  <plugin>
+    org.contikios.cooja.plugins.Visualizer
+    <plugin_config>
+      <moterelations>true</moterelations>
+      <skin>org.contikios.cooja.plugins.skins.IDVisualizerSkin</skin>
+      <skin>org.contikios.cooja.plugins.skins.GridVisualizerSkin</skin>
+      <skin>org.contikios.cooja.plugins.skins.TrafficVisualizerSkin</skin>
+      <skin>org.contikios.cooja.plugins.skins.UDGMVisualizerSkin</skin>
+      <viewport>5.609602098170124 0.0 0.0 5.609602098170124 -42.13888607109028 29.393847469171753</viewport>
+    </plugin_config>
+    <bounds x="1" y="118" height="264" width="400" z="4" />
+  </plugin>
+  <plugin>
+    org.contikios.cooja.plugins.LogListener
+    <plugin_config>
+      <filter />
+      <formatted_time />
+      <coloring />
+    </plugin_config>
+    <bounds x="400" y="126" height="372" width="734" z="3" />
+  </plugin>
+  <plugin>
+    org.contikios.cooja.plugins.TimeLine
+    <plugin_config>
+      <mote>0</mote>
+      <mote>1</mote>
+      <mote>2</mote>
+      <showRadioRXTX />
+      <showRadioHW />
+      <showLEDs />
+      <zoomfactor>500.0</zoomfactor>
+    </plugin_config>
+    <bounds x="0" y="501" height="166" width="1134" z="7" />
+  </plugin>
+  <plugin>
+    org.contikios.cooja.serialsocket.SerialSocketServer
+    <mote_arg>0</mote_arg>
+    <plugin_config>
+      <port>60001</port>
+      <bound>true</bound>
+    </plugin_config>
+    <bounds x="0" y="0" height="116" width="362" z="6" />
+  </plugin>
+  <plugin>
+    org.contikios.cooja.plugins.MoteInterfaceViewer
+    <mote_arg>1</mote_arg>
+    <plugin_config>
+      <interface>LEDs</interface>
+      <scrollpos>0,0</scrollpos>
+    </plugin_config>
+    <bounds x="419" y="6" height="117" width="350" z="5" />
+  </plugin>
+  <plugin>
+    org.contikios.cooja.plugins.MoteInterfaceViewer
+    <mote_arg>2</mote_arg>
+    <plugin_config>
+      <interface>LEDs</interface>
+      <scrollpos>0,0</scrollpos>
+    </plugin_config>
+    <bounds x="776" y="9" height="117" width="350" />
+  </plugin>
+  <plugin>
+    org.contikios.cooja.plugins.MoteInterfaceViewer
+    <mote_arg>2</mote_arg>
+    <plugin_config>
+      <interface>ContikiButton</interface>
+      <scrollpos>0,0</scrollpos>
+    </plugin_config>
+    <bounds x="59" y="507" height="126" width="350" z="2" />
+  </plugin>
+  <plugin>
+    org.contikios.cooja.plugins.MoteInterfaceViewer
+    <mote_arg>1</mote_arg>
+    <plugin_config>
+      <interface>ContikiButton</interface>
+      <scrollpos>0,0</scrollpos>
+    </plugin_config>
+    <bounds x="43" y="386" height="124" width="350" z="1" />
+  </plugin>
+  <plugin>
+    org.contikios.cooja.plugins.ScriptRunner
+    <plugin_config>
+      <script>/*
+ * Adaptive sensing period against the former fixed 3 s period, on the detector (mote 2).
+ * For each mode the sensing bounds are set through the serial console ("sensing &lt;min&gt; &lt;max&gt;"):
+ *  - quiet phase: duty cycles averaged over the Energest reports (common/energy.h);
+ *  - fire phase: simulated ignition (button held 3 s), detection latency from the
+ *    "Detection latency" log line, duty cycles over the following reports;
+ *  then the fire is stopped (button held again) and the detector left to settle.
+ */
+TIMEOUT(3000000, log.log("adaptive sensing scenario timed out\n"));
+
+var DETECTOR = 2;
+var MODES = [["fixed 3 s", "sensing 3 3"], ["adaptive 1-15 s", "sensing 1 15"]];
+var QUIET_REPORTS = 10;
+var FIRE_REPORTS = 5;
+var SETTLE_REPORTS = 3;
+var REPORT = /window (\d+) ms, cpu (\d+), lpm \d+, deep lpm \d+, tx (\d+), rx (\d+) ms/;
+var LATENCY = /Detection latency: (\d+) s/;
+
+var detector = sim.getMoteWithID(DETECTOR);
+var button = detector.getInterfaces().getButton();
+var results = [];
+
+function hold_button(ms) {
+  button.pressButton();
+  GENERATE_MSG(ms, "release");
+  YIELD_THEN_WAIT_UNTIL(msg.equals("release"));
+  button.releaseButton();
+}
+
+function is_report() {
+  return id == DETECTOR &amp;&amp; REPORT.test(msg);
+}
+
+// duty cycles of the next n reports, %; latency: seconds of the first detection seen meanwhile
+function duty_cycles(n) {
+  var window = 0, cpu = 0, radio = 0, latency = -1;
+  for(var i = 0; i &lt; n; ) {
+    YIELD_THEN_WAIT_UNTIL(id == DETECTOR &amp;&amp; (REPORT.test(msg) || LATENCY.test(msg)));
+    if(LATENCY.test(msg)) {
+      if(latency &lt; 0) latency = parseInt(msg.match(LATENCY)[1], 10);
+      continue;
+    }
+    var m = msg.match(REPORT);
+    window += parseInt(m[1], 10);
+    cpu += parseInt(m[2], 10);
+    radio += parseInt(m[3], 10) + parseInt(m[4], 10);
+    i++;
+  }
+  return { cpu: 100 * cpu / window, radio: 100 * radio / window, latency: latency };
+}
+
+YIELD_THEN_WAIT_UNTIL(is_report()); // detector booted, first window
+for(var k = 0; k &lt; MODES.length; k++) {
+  write(detector, MODES[k][1]);
+  YIELD_THEN_WAIT_UNTIL(is_report()); // window across the change
+
+  var quiet = duty_cycles(QUIET_REPORTS);
+  hold_button(3000); // simulated ignition
+  var fire = duty_cycles(FIRE_REPORTS);
+  hold_button(3000); // end of the fire
+  duty_cycles(SETTLE_REPORTS);
+
+  results.push(MODES[k][0] + ": quiet cpu " + quiet.cpu.toFixed(2) + " %, radio " + quiet.radio.toFixed(2)
+               + " %; fire cpu " + fire.cpu.toFixed(2) + " %, radio " + fire.radio.toFixed(2)
+               + " %; detection latency " + (fire.latency &lt; 0 ? "none" : fire.latency + " s"));
+  log.log(results[results.length - 1] + "\n");
+}
+
+log.log("Sensing period modes (duty cycles over " + QUIET_REPORTS + "/" + FIRE_REPORTS + " reports):\n");
+for(var k = 0; k &lt; results.length; k++) {
+  log.log("  " + results[k] + "\n");
+}
+log.testOK();
+</script>
+      <active>true</active>
+    </plugin_config>
+    <bounds x="1134" y="0" height="700" width="600" z="0" />
+  </plugin>
+</simconf>
@@ -0,0 +1,108 @@
+#include "energy.h"
+
+#if ENERGEST_CONF_ON
+#include "sys/energest.h"
+#include "sys/ctimer.h"
+#include "sys/log.h"
+#include <stdio.h> // for snprintf
+
+#define LOG_MODULE "Energy"
+#define LOG_LEVEL LOG_LEVEL_APP
+
+#define ENERGY_APP_TYPE(name, type) ENERGEST_TYPE_##type,
+static const energest_type_t app_types[ENERGY_APP_COUNT] = { ENERGY_APP_TABLE(ENERGY_APP_TYPE) };
+#undef ENERGY_APP_TYPE
+
+#define ENERGY_APP_NAME(name, type) #name,
+static const char *const app_names[ENERGY_APP_COUNT] = { ENERGY_APP_TABLE(ENERGY_APP_NAME) };
+#undef ENERGY_APP_NAME
+
+static struct ctimer report_timer;
+static coap_resource_t *report_resource;
+static energy_window_t last;
+
+// Energest totals at the start of the window
+static uint64_t cpu0, lpm0, deep_lpm0, tx0, rx0;
+static uint64_t app0[ENERGY_APP_COUNT];
+
+static uint32_t to_ms(uint64_t ticks) {
+  return (uint32_t)(ticks * 1000 / ENERGEST_SECOND);
+}
+
+// window time of an Energest type, the start total moves to now
+static uint32_t window_ms(energest_type_t type, uint64_t *start) {
+  uint64_t now = energest_type_time(type);
+  uint32_t ms = to_ms(now - *start);
+  *start = now;
+  return ms;
+}
+
+static void report(void *ptr) {
+  (void)ptr;
+  energest_flush();
+
+  last.cpu = window_ms(ENERGEST_TYPE_CPU, &cpu0);
+  last.lpm = window_ms(ENERGEST_TYPE_LPM, &lpm0);
+  last.deep_lpm = window_ms(ENERGEST_TYPE_DEEP_LPM, &deep_lpm0);
+  last.tx = window_ms(ENERGEST_TYPE_TRANSMIT, &tx0);
+  last.rx = window_ms(ENERGEST_TYPE_LISTEN, &rx0);
+  for(int i = 0; i < ENERGY_APP_COUNT; i++) {
+    last.app[i] = window_ms(app_types[i], &app0[i]);
+  }
+  last.window = last.cpu + last.lpm + last.deep_lpm;
+  last.reports++;
+
+  // charge over the window (uA * ms), radio on top of the MCU states
+  uint64_t charge = (uint64_t)last.cpu * ENERGY_CURRENT_CPU + (uint64_t)last.lpm * ENERGY_CURRENT_LPM +
+                    (uint64_t)last.deep_lpm * ENERGY_CURRENT_DEEP_LPM +
+                    (uint64_t)last.tx * ENERGY_CURRENT_TX + (uint64_t)last.rx * ENERGY_CURRENT_RX;
+  last.avg_ua = last.window ? (uint32_t)(charge / last.window) : 0;
+  last.mah_day = (uint32_t)((uint64_t)last.avg_ua * 24 / 10); // uA * 24 h / 1000 * 100
+
+  LOG_INFO("Energy: window %lu ms, cpu %lu, lpm %lu, deep lpm %lu, tx %lu, rx %lu ms, avg %lu uA, %lu.%02lu mAh/day\n",
+           (unsigned long)last.window, (unsigned long)last.cpu, (unsigned long)last.lpm,
+           (unsigned long)last.deep_lpm, (unsigned long)last.tx, (unsigned long)last.rx,
+           (unsigned long)last.avg_ua, (unsigned long)(last.mah_day / 100), (unsigned long)(last.mah_day % 100));
+  for(int i = 0; i < ENERGY_APP_COUNT; i++) {
+    LOG_DBG("Energy: %s %lu ms\n", app_names[i], (unsigned long)last.app[i]);
+  }
+
+  if(report_resource) {
+    report_resource->trigger();
+  }
+  ctimer_reset(&report_timer);
+}
+
+void energy_init(coap_resource_t *resource) {
+  report_resource = resource;
+  energest_flush();
+  cpu0 = energest_type_time(ENERGEST_TYPE_CPU);
+  lpm0 = energest_type_time(ENERGEST_TYPE_LPM);
+  deep_lpm0 = energest_type_time(ENERGEST_TYPE_DEEP_LPM);
+  tx0 = energest_type_time(ENERGEST_TYPE_TRANSMIT);
+  rx0 = energest_type_time(ENERGEST_TYPE_LISTEN);
+  for(int i = 0; i < ENERGY_APP_COUNT; i++) {
+    app0[i] = energest_type_time(app_types[i]);
+  }
+  ctimer_set(&report_timer, ENERGY_REPORT_PERIOD * CLOCK_SECOND, report, NULL);
+}
+
+const energy_window_t *energy_last_window(void) {
+  return &last;
+}
+
+int energy_serialize(char *buffer, int size) {
+  int len = snprintf(buffer, size,
+                     "\"w\":%lu,\"cpu\":%lu,\"lpm\":%lu,\"dlpm\":%lu,\"tx\":%lu,\"rx\":%lu",
+                     (unsigned long)last.window, (unsigned long)last.cpu, (unsigned long)last.lpm,
+                     (unsigned long)last.deep_lpm, (unsigned long)last.tx, (unsigned long)last.rx);
+  for(int i = 0; i < ENERGY_APP_COUNT; i++) {
+    len += snprintf(buffer + (len < size ? len : size), len < size ? size - len : 0, ",\"%s\":%lu",
+                    app_names[i], (unsigned long)last.app[i]);
+  }
+  len += snprintf(buffer + (len < size ? len : size), len < size ? size - len : 0,
+                  ",\"uA\":%lu,\"mAh_day\":%lu.%02lu", (unsigned long)last.avg_ua,
+                  (unsigned long)(last.mah_day / 100), (unsigned long)(last.mah_day % 100));
+  return len;
+}
+#endif
@@ -0,0 +1,86 @@
+#ifndef ENERGY_H
+#define ENERGY_H
+
+#include <stdint.h>
+#include "contiki.h"
+#include "coap-engine.h"
+
+/* Energy accounting on Energest (ENERGEST_CONF_ON, project-conf.h): every ENERGY_REPORT_PERIOD
+*  the time spent in CPU, LPM, deep LPM, radio TX and RX over the last window is turned into an
+*  average supply current and a mAh/day estimate with the current model below. The application
+*  subsystems are Energest types of their own (ENERGEST_CONF_ADDITIONS): their time is part of the
+*  CPU time, not added to it. Shared by the detector and vent firmwares (MODULES_REL += ../common).
+*/
+
+#ifndef ENERGY_REPORT_PERIOD
+#define ENERGY_REPORT_PERIOD 60 // sec
+#endif
+
+/* Supply current of each state, uA */
+#if defined(NRF52840_XXAA) || defined(CONTIKI_TARGET_NRF52840)
+// nRF52840 at 3 V with the DC/DC converter (product specification)
+#define ENERGY_CURRENT_CPU      3300
+#define ENERGY_CURRENT_LPM      3
+#define ENERGY_CURRENT_DEEP_LPM 1
+#define ENERGY_CURRENT_TX       4800  // 0 dBm
+#define ENERGY_CURRENT_RX       4600
+#else
+// Tmote Sky (MSP430 + CC2420), the usual model for Cooja motes
+#define ENERGY_CURRENT_CPU      1800
+#define ENERGY_CURRENT_LPM      55
+#define ENERGY_CURRENT_DEEP_LPM 55
+#define ENERGY_CURRENT_TX       17400 // 0 dBm
+#define ENERGY_CURRENT_RX       18800
+#endif
+
+/* Application subsystems accounted by Energest (must match ENERGEST_CONF_ADDITIONS): the detector
+*  stages, switched by the stage macros (smart_smoke_detector/lib/stage_timing.h), unless
+*  project-conf.h has its own table. ENERGY_APP_ON/OFF take the upper-case Energest type of a row
+*  (ENERGY_APP_ON(ACTUATION)), not its lower-case name.
+*/
+#ifndef ENERGY_APP_TABLE
+#define ENERGY_APP_TABLE(X) \
+  X(sensing,   SENSING)   /* measurements and series update */ \
+  X(inference, INFERENCE) /* trend detection and fire model */ \
+  X(encoding,  ENCODING)  /* SenML encoding */                  \
+  X(notify,    NOTIFY)    /* observer notifications */
+#endif
+
+#define ENERGY_APP_ENUM(name, type) ENERGY_APP_##name,
+typedef enum { ENERGY_APP_TABLE(ENERGY_APP_ENUM) ENERGY_APP_COUNT } energy_app_t;
+#undef ENERGY_APP_ENUM
+
+#if ENERGEST_CONF_ON
+#include "sys/energest.h"
+#define ENERGY_APP_ON(type) ENERGEST_ON(ENERGEST_TYPE_##type)
+#define ENERGY_APP_OFF(type) ENERGEST_OFF(ENERGEST_TYPE_##type)
+#else
+#define ENERGY_APP_ON(type)
+#define ENERGY_APP_OFF(type)
+#endif
+
+/* Figures of the last window, ms */
+typedef struct {
+    uint32_t window;
+    uint32_t cpu;
+    uint32_t lpm;
+    uint32_t deep_lpm;
+    uint32_t tx;
+    uint32_t rx;
+    uint32_t app[ENERGY_APP_COUNT];
+    uint32_t avg_ua;     // average supply current over the window
+    uint32_t mah_day;    // mAh/day at that current, * 100
+    uint32_t reports;    // windows since boot
+} energy_window_t;
+
+#if ENERGEST_CONF_ON
+// starts the periodic reports, 'resource' is triggered after each of them (may be NULL)
+void energy_init(coap_resource_t *resource);
+
+const energy_window_t *energy_last_window(void);
+
+// JSON members of the last window ("w":..,"cpu":..,...,"mAh_day":..), snprintf-like length
+int energy_serialize(char *buffer, int size);
+#endif
+
+#endif // ENERGY_H
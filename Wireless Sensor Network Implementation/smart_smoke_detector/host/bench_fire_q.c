@@ -0,0 +1,84 @@
+/* Host benchmark of the quantized fire detector:
+*  latency of eml_net_predict() on the float model (fire_detector.h) against fire_qnet_predict()
+*  on the int8/int16 one (fire_detector_q.h), and agreement of their decisions.
+*  Inputs: the Kaggle smoke detection CSV when given (ground truth "Fire Alarm" column included),
+*  otherwise a sensor_sim run cycling through normal, fire and hazard phases.
+*
+*    ./bench-fire-q [smoke_detection_iot.csv] [repetitions]
+*/
+#include "fire_detector.h"
+#include "fire_detector_q.h"
+#include "fire_dataset.h"
+#include "lib/fire_features.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define MAX_ROWS 80000
+#define SIM_ROWS 20000
+#define SIM_PHASE 200 // measurements per simulated phase
+#define DEFAULT_REPETITIONS 5
+
+static fire_sample samples[MAX_ROWS];
+static float rows[MAX_ROWS][FIRE_MODEL_FEATURES]; // normalized
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+int main(int argc, char **argv) {
+    int n = (argc > 1) ? fire_dataset_load(argv[1], samples, MAX_ROWS) : fire_dataset_simulate(samples, SIM_ROWS, SIM_PHASE);
+    int repetitions = (argc > 2) ? atoi(argv[2]) : DEFAULT_REPETITIONS;
+    static unsigned char float_class[MAX_ROWS], quant_class[MAX_ROWS];
+    volatile int32_t sink = 0;
+    (void)eml_net_activation_function_strs; // unused static of eml_net.h
+
+    if (n <= 0) {
+        return 1;
+    }
+    for (int i = 0; i < n; i++) {
+        normalize_features(&samples[i].sensors, rows[i]);
+    }
+
+    double t0 = now_ns();
+    for (int r = 0; r < repetitions; r++) {
+        for (int i = 0; i < n; i++) {
+            float_class[i] = (unsigned char)eml_net_predict(&fire_detector, rows[i], FIRE_MODEL_FEATURES);
+        }
+    }
+    double float_ns = (now_ns() - t0) / ((double)n * repetitions);
+
+    t0 = now_ns();
+    for (int r = 0; r < repetitions; r++) {
+        for (int i = 0; i < n; i++) {
+            quant_class[i] = (unsigned char)fire_qnet_predict(&fire_detector_q, rows[i], FIRE_MODEL_FEATURES);
+        }
+    }
+    double quant_ns = (now_ns() - t0) / ((double)n * repetitions);
+
+    int agree = 0, labelled = 0, float_ok = 0, quant_ok = 0, float_fire = 0;
+    for (int i = 0; i < n; i++) {
+        agree += (float_class[i] == quant_class[i]);
+        float_fire += float_class[i];
+        if (samples[i].label >= 0) {
+            labelled++;
+            float_ok += (float_class[i] == samples[i].label);
+            quant_ok += (quant_class[i] == samples[i].label);
+        }
+        sink += quant_class[i];
+    }
+
+    printf("Fire detector inference, %d inputs (%s), %d repetitions\n", n, (argc > 1) ? argv[1] : "sensor_sim", repetitions);
+    printf("  eml_net_predict (float) : %8.1f ns/inference\n", float_ns);
+    printf("  fire_qnet_predict (int) : %8.1f ns/inference\n", quant_ns);
+    printf("  speedup                 : %8.2fx\n", float_ns / quant_ns);
+    printf("  agreement               : %d/%d (%.2f%%), %d fire decisions of the float model\n",
+           agree, n, 100.0 * agree / n, float_fire);
+    if (labelled) {
+        printf("  accuracy (Fire Alarm)   : float %.2f%%, quantized %.2f%%\n",
+               100.0 * float_ok / labelled, 100.0 * quant_ok / labelled);
+    }
+    return (sink < 0);
+}
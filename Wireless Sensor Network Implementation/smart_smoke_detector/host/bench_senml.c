@@ -0,0 +1,137 @@
+/* Host microbenchmark of the SenML JSON encoder:
+*  ns/record of create_senml_json() against the previous snprintf + setlocale implementation,
+*  over a full HISTORY_SIZE window of every detector series.
+*/
+#include "lib/senml_series.h"
+#include "os/sys/clock.h"
+#include <locale.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define DEFAULT_ITERATIONS 200000
+
+typedef struct {
+    const char *name;
+    const char *unit;
+    senml_value_type type;
+    float scale;   // history column scaling, as in lib/sensor_table.h
+    int32_t offset;
+    float fstart;
+    int istart;
+} bench_series;
+
+static const bench_series bench_table[] = {
+    { "temp",        "C",            SENML_FLOAT, 100.0f, 0,     15.23f,  0     },
+    { "hum",         "%",            SENML_FLOAT, 100.0f, 0,     25.17f,  0     },
+    { "pressure",    "hPa",          SENML_FLOAT, 100.0f, 900,   936.91f, 0     },
+    { "tvoc",        "ppb",          SENML_INT,   1.0f,   30000, 0.0f,    38012 },
+    { "raw_h2",      "ppm",          SENML_INT,   1.0f,   0,     0.0f,    11302 },
+    { "raw_ethanol", "ppm",          SENML_INT,   1.0f,   0,     0.0f,    16498 },
+    { "pm1_0",       "\xc2\xb5g/m3", SENML_INT,   1.0f,   32768, 0.0f,    3     },
+    { "pm2_5",       "\xc2\xb5g/m3", SENML_INT,   1.0f,   32768, 0.0f,    4     },
+    { "nc0_5",       "p/cm3",        SENML_INT,   1.0f,   32768, 0.0f,    12    },
+};
+#define BENCH_SERIES (sizeof(bench_table) / sizeof(bench_table[0]))
+
+/* Reference: the encoder as it was before the fixed-point emitters (one or two snprintf per record,
+*  setlocale on every encode), fed with the same window in plain arrays.
+*/
+static void legacy_senml_json(const char *name, const char *unit, const long *values, const unsigned long *times,
+                              int m, char *payload, unsigned int payload_size) {
+    unsigned long base_time = times[0];
+    int written = snprintf(payload, payload_size,
+        "{\"bn\":\"%s%s\",\"bu\":\"%s\",\"ver\":%d,\"bt\":%lu,\"e\":[",
+        BASE_NAME, name, unit, VERSION, base_time);
+
+    setlocale(LC_NUMERIC, "C");
+
+    for (int i = 0; i < m && written < (int)payload_size; i++) {
+        int rel_time = (int)(times[i] - base_time);
+        if (i > 0) {
+            written += snprintf(payload + written, payload_size - written, ",");
+        }
+        written += snprintf(payload + written, payload_size - written,
+            "{\"v\":%d,\"t\":%d}", (int)values[i], rel_time);
+    }
+    snprintf(payload + written, payload_size - written, "]}");
+}
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+int main(int argc, char **argv) {
+    long iterations = (argc > 1) ? atol(argv[1]) : DEFAULT_ITERATIONS;
+    static senml_series series[BENCH_SERIES];
+    static long values[BENCH_SERIES][HISTORY_SIZE];
+    static unsigned long times[BENCH_SERIES][HISTORY_SIZE];
+    char payload[1024];
+    char reference[1024];
+    volatile unsigned int sink = 0;
+
+    /* ---- full window of every series, 3 s apart, on a shared timeline ---- */
+    static senml_timeline timeline;
+    senml_timeline_init(&timeline);
+    for (unsigned int s = 0; s < BENCH_SERIES; s++) {
+        const bench_series *b = &bench_table[s];
+        init_measurements_series(&series[s], &timeline, b->name, b->unit, b->type);
+        senml_series_set_scaling(&series[s], b->scale, b->offset);
+    }
+    for (int i = 0; i < HISTORY_SIZE; i++) {
+        host_clock_set(1000 + i * 3);
+        senml_timeline_advance(&timeline);
+        for (unsigned int s = 0; s < BENCH_SERIES; s++) {
+            const bench_series *b = &bench_table[s];
+            times[s][i] = 1000 + i * 3;
+            if (b->type == SENML_FLOAT) {
+                float v = b->fstart + 0.05f * i;
+                add_measurement(&series[s], v);
+                values[s][i] = (long)(v * 100.0f + 0.5f); // payload resolution, rounded
+            } else {
+                add_measurement_int(&series[s], b->istart + i);
+                values[s][i] = b->istart + i;
+            }
+        }
+    }
+
+    // both encoders must produce the same document
+    for (unsigned int s = 0; s < BENCH_SERIES; s++) {
+        const bench_series *b = &bench_table[s];
+        create_senml_json(&series[s], payload, sizeof(payload), -1);
+        legacy_senml_json(b->name, b->unit, values[s], times[s], HISTORY_SIZE, reference, sizeof(reference));
+        if (strcmp(payload, reference) != 0) {
+            fprintf(stderr, "payload mismatch on %s:\n  %s\n  %s\n", b->name, payload, reference);
+            return 1;
+        }
+    }
+
+    long records = iterations * (long)BENCH_SERIES * HISTORY_SIZE;
+
+    double t0 = now_ns();
+    for (long it = 0; it < iterations; it++) {
+        for (unsigned int s = 0; s < BENCH_SERIES; s++) {
+            legacy_senml_json(bench_table[s].name, bench_table[s].unit, values[s], times[s], HISTORY_SIZE, payload, sizeof(payload));
+            sink += (unsigned char)payload[7];
+        }
+    }
+    double legacy_ns = (now_ns() - t0) / records;
+
+    t0 = now_ns();
+    for (long it = 0; it < iterations; it++) {
+        for (unsigned int s = 0; s < BENCH_SERIES; s++) {
+            create_senml_json(&series[s], payload, sizeof(payload), -1);
+            sink += (unsigned char)payload[7];
+        }
+    }
+    double current_ns = (now_ns() - t0) / records;
+
+    printf("SenML JSON encoding, %d series x %d records, %ld iterations\n", (int)BENCH_SERIES, HISTORY_SIZE, iterations);
+    printf("  snprintf (legacy)   : %8.1f ns/record\n", legacy_ns);
+    printf("  create_senml_json   : %8.1f ns/record\n", current_ns);
+    printf("  speedup             : %8.2fx\n", legacy_ns / current_ns);
+    return (sink == 0xFFFFFFFFu);
+}
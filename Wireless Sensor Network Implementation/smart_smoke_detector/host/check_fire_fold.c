@@ -0,0 +1,58 @@
+/* Regression check of the folded fire detector (fire_detector_folded.h, raw sensor inputs)
+*  against the emlearn model fed with normalized inputs (fire_detector.h), in float32 as on
+*  the target, on the rows of the dataset the model was trained on. Fails when an output differs
+*  by more than the tolerance, or when any decision differs.
+*
+*    ./check-fire-fold smoke_detection_iot.csv [tolerance]
+*/
+#include "fire_detector_folded.h"
+#include "fire_dataset.h"
+#include "lib/fire_features.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define MAX_ROWS 80000
+#define DEFAULT_TOLERANCE 1e-3 // float32 rounding of the large folded products (pressure, raw gases)
+
+static fire_sample samples[MAX_ROWS];
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s smoke_detection_iot.csv [tolerance]\n", argv[0]);
+        return 1;
+    }
+    int n = fire_dataset_load(argv[1], samples, MAX_ROWS);
+    double tolerance = (argc > 2) ? atof(argv[2]) : DEFAULT_TOLERANCE;
+    double worst = 0.0;
+    int worst_row = 0, flipped = 0, failures = 0;
+    (void)eml_net_activation_function_strs; // unused static of eml_net.h
+
+    if (n <= 0) {
+        return 1;
+    }
+    for (int i = 0; i < n; i++) {
+        float features[FIRE_MODEL_FEATURES], raw[FIRE_MODEL_FEATURES];
+        normalize_features(&samples[i].sensors, features);
+        raw_features(&samples[i].sensors, raw);
+        float reference = eml_net_regress1(&fire_detector, features, FIRE_MODEL_FEATURES);
+        float folded = eml_net_regress1(&fire_detector_folded, raw, FIRE_MODEL_FEATURES);
+        double diff = fabs((double)folded - reference);
+        if (diff > worst) {
+            worst = diff;
+            worst_row = i;
+        }
+        if ((folded > 0.5f) != (reference > 0.5f)) {
+            flipped++;
+            failures++;
+        } else if (diff > tolerance) {
+            failures++;
+        }
+    }
+
+    printf("Folded normalization check, %d inputs (%s)\n", n, argv[1]);
+    printf("  max output difference : %.3g (row %d)\n", worst, worst_row);
+    printf("  decisions flipped     : %d\n", flipped);
+    printf("  %s (tolerance %g)\n", failures ? "FAILED" : "passed", tolerance);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,139 @@
+/* Host check of the history column scaling of lib/sensor_table.h: every sensor series, scaled as in
+*  the firmware, must give back through get_nth_last_payload() and the running statistics the value
+*  added with add_measurement(), over the whole range of the Kaggle smoke detection dataset.
+*    ./check-senml-columns [smoke_detection_iot.csv]
+*  The dataset extremes of every column are always replayed; with a trace, all of its rows too.
+*/
+#include "lib/sensor_table.h"
+#include "lib/sensor_trace.h"
+#include "os/sys/clock.h"
+#include <math.h>
+#include <stddef.h> // for offsetof
+#include <stdio.h>
+#include <string.h>
+
+void host_clock_set(unsigned long seconds);
+
+typedef struct {
+    const char *name;
+    senml_value_type type;
+    float scale;
+    int32_t offset;
+    size_t field;
+} check_row;
+
+#define CHECK_ROW(id, field, title, rt, unit, type, scale, offset, ...) { #id, type, scale, offset, offsetof(sensor_sim_t, field) },
+static const check_row rows[SENSOR_COUNT] = { SENSOR_TABLE(CHECK_ROW) };
+#undef CHECK_ROW
+
+/* Column extremes of smoke_detection_iot.csv, in the sensor_sim_t field order of the table rows */
+static const float dataset_min[SENSOR_COUNT] = { -22.01f, 10.74f, 930.852f, 0, 10668, 15317, 0, 0, 0 };
+static const float dataset_max[SENSOR_COUNT] = { 59.93f, 75.2f, 939.861f, 60000, 13803, 21410, 14333.69f, 45432.26f, 61482.03f };
+
+static senml_timeline timeline;
+static senml_series series[SENSOR_COUNT];
+static long expected_min[SENSOR_COUNT], expected_max[SENSOR_COUNT];
+static unsigned long now = 1000;
+static long checked, mismatches;
+
+// payload of a sensed value: floats * 100, ints as the trace parser rounds them
+static long expected_payload(const check_row *row, float value) {
+    return row->type == SENML_FLOAT ? lroundf(value * 100.0f) : lroundf(value);
+}
+
+static void add_row(const float *values) {
+    host_clock_set(now);
+    now += 3;
+    senml_timeline_advance(&timeline);
+    for (int s = 0; s < SENSOR_COUNT; s++) {
+        const check_row *row = &rows[s];
+        long expected = expected_payload(row, values[s]);
+        if (row->type == SENML_FLOAT) {
+            add_measurement(&series[s], values[s]);
+        } else {
+            add_measurement_int(&series[s], (int)expected);
+        }
+        long payload = get_nth_last_payload(&series[s], 1);
+        checked++;
+        if (payload != expected) {
+            if (mismatches++ < 10) {
+                fprintf(stderr, "%s: added %.3f, payload %ld, expected %ld\n", row->name, values[s], payload, expected);
+            }
+        }
+        if (expected < expected_min[s]) expected_min[s] = expected;
+        if (expected > expected_max[s]) expected_max[s] = expected;
+    }
+}
+
+static void add_sensors(const sensor_sim_t *sensors) {
+    float values[SENSOR_COUNT];
+    for (int s = 0; s < SENSOR_COUNT; s++) {
+        const char *field = (const char *)sensors + rows[s].field;
+        values[s] = rows[s].type == SENML_FLOAT ? *(const float *)field : (float)*(const int *)field;
+    }
+    add_row(values);
+}
+
+static int replay_trace(const char *path) {
+    static char line[1024];
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        perror(path);
+        return -1;
+    }
+    sensor_trace_header header;
+    const char *missing = NULL;
+    if (!fgets(line, sizeof(line), f) || sensor_trace_parse_header(&header, line, &missing) < 0) {
+        fprintf(stderr, "%s: missing column %s\n", path, missing ? missing : "(empty file)");
+        fclose(f);
+        return -1;
+    }
+    int rows_read = 0;
+    sensor_sim_t sensors;
+    memset(&sensors, 0, sizeof(sensors));
+    while (fgets(line, sizeof(line), f)) {
+        int label;
+        if (sensor_trace_parse_row(&header, line, &sensors, &label, NULL) == 0) {
+            add_sensors(&sensors);
+            rows_read++;
+        }
+    }
+    fclose(f);
+    return rows_read;
+}
+
+int main(int argc, char **argv) {
+    senml_timeline_init(&timeline);
+    for (int s = 0; s < SENSOR_COUNT; s++) {
+        init_measurements_series(&series[s], &timeline, rows[s].name, "", rows[s].type);
+        senml_series_set_scaling(&series[s], rows[s].scale, rows[s].offset);
+        expected_min[s] = INT32_MAX;
+        expected_max[s] = INT32_MIN;
+    }
+
+    // extremes, midpoints and back
+    float values[SENSOR_COUNT];
+    for (int step = 0; step <= 8; step++) {
+        float w = (step <= 4 ? step : 8 - step) / 4.0f;
+        for (int s = 0; s < SENSOR_COUNT; s++) {
+            values[s] = dataset_min[s] + (dataset_max[s] - dataset_min[s]) * w;
+        }
+        add_row(values);
+    }
+    int trace_rows = 0;
+    if (argc > 1 && (trace_rows = replay_trace(argv[1])) < 0) {
+        return 1;
+    }
+
+    // the statistics are fed the value read back from the column
+    for (int s = 0; s < SENSOR_COUNT; s++) {
+        if (series[s].stats.min != expected_min[s] || series[s].stats.max != expected_max[s]) {
+            fprintf(stderr, "%s: stats min/max %ld/%ld, expected %ld/%ld\n", rows[s].name,
+                    (long)series[s].stats.min, (long)series[s].stats.max, expected_min[s], expected_max[s]);
+            mismatches++;
+        }
+    }
+
+    printf("History columns: %ld values checked (%d trace rows), %ld mismatches\n", checked, trace_rows, mismatches);
+    return mismatches != 0;
+}
@@ -0,0 +1,9 @@
+#ifndef HOST_COAP_ENGINE_H_
+#define HOST_COAP_ENGINE_H_
+
+/* Host-native stand-in for Contiki's coap-engine.h: only the types named by the lib/ headers
+*  the host tools include (lib/sensor_table.h), no CoAP engine.
+*/
+typedef struct coap_resource_s coap_resource_t;
+
+#endif /* HOST_COAP_ENGINE_H_ */
@@ -0,0 +1,45 @@
+#include "fire_dataset.h"
+#include "lib/sensor_trace.h"
+#include <stdio.h>
+#include <string.h>
+
+int fire_dataset_load(const char *path, fire_sample *samples, int max) {
+    FILE *fp = fopen(path, "r");
+    char line[512];
+    sensor_trace_header header;
+    const char *missing = NULL;
+    int n = 0, line_no = 1;
+    if (!fp) {
+        perror(path);
+        return -1;
+    }
+    if (!fgets(line, sizeof(line), fp) || sensor_trace_parse_header(&header, line, &missing) < 0) {
+        fprintf(stderr, "%s: missing column %s\n", path, missing ? missing : "(empty file)");
+        fclose(fp);
+        return -1;
+    }
+    while (n < max && fgets(line, sizeof(line), fp)) {
+        int label;
+        line_no++;
+        memset(&samples[n], 0, sizeof(samples[n]));
+        if (sensor_trace_parse_row(&header, line, &samples[n].sensors, &label, NULL) < 0) {
+            fprintf(stderr, "%s:%d: short line, skipped\n", path, line_no);
+            continue;
+        }
+        samples[n++].label = (signed char)label;
+    }
+    fclose(fp);
+    return n;
+}
+
+int fire_dataset_simulate(fire_sample *samples, int n, int phase_len) {
+    sensor_sim_t s;
+    simulate_first_measurements(&s);
+    for (int i = 0; i < n; i++) {
+        int phase = (i / phase_len) % 3; // normal, fire, hazard
+        simulate_new_measurements(&s, phase == 1, phase == 2);
+        samples[i].sensors = s;
+        samples[i].label = -1;
+    }
+    return n;
+}
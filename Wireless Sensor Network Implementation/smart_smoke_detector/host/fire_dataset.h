@@ -0,0 +1,22 @@
+#ifndef FIRE_DATASET_H
+#define FIRE_DATASET_H
+
+#include "lib/sensor_sim.h"
+
+/* Inputs of the host fire detector tools: rows of a sensor trace CSV (lib/sensor_trace.h,
+*  "Fire Alarm" as ground truth when present), or a sensor_sim run cycling through normal,
+*  fire and hazard phases (no ground truth).
+*/
+
+typedef struct {
+    sensor_sim_t sensors;
+    signed char label; // Fire Alarm column, -1: unknown
+} fire_sample;
+
+// returns the number of rows read (at most max), -1 on error
+int fire_dataset_load(const char *path, fire_sample *samples, int max);
+
+// n samples of a sensor_sim run, phases of phase_len measurements
+int fire_dataset_simulate(fire_sample *samples, int n, int phase_len);
+
+#endif // FIRE_DATASET_H
@@ -0,0 +1,208 @@
+/* Load generator of virtual detectors for the cloud ingestion: a sensor fleet (sensor_fleet.h)
+*  stepped measurement after measurement, every reading written as a CSV line in the sensor trace
+*  layout (lib/sensor_trace.h) plus the detector index, the Fire Alarm column being the ground
+*  truth of the fire episodes. Without -o the readings are only generated (simulator throughput).
+*
+*    ./fleet-load [-n detectors] [-m measurements] [-f fire_p] [-z hazard_p] [-l episode_len]
+*                 [-s seed] [-p period_sec] [-o out.csv|-] [-c]
+*
+*  -c checks the first detectors against sensor_sim_t simulators (lib/sensor_sim.c) stepped
+*  with the same seeds and episodes.
+*/
+#include "sensor_fleet.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define DEFAULT_DETECTORS 10000
+#define DEFAULT_MEASUREMENTS 1000
+#define DEFAULT_EPISODE_LEN 20
+#define DEFAULT_PERIOD 3 // sec, SENSORS_UPDATE_PERIOD
+#define TRACE_START 1654733331UL // first UTC of the dataset
+#define CHECKED_DETECTORS 64
+
+#define OUT_BUFFER_SIZE (1 << 20)
+#define MAX_LINE_LEN 160
+
+static const char header[] =
+    "Detector,UTC,Temperature[C],Humidity[%],TVOC[ppb],Raw H2,Raw Ethanol,Pressure[hPa],PM1.0,PM2.5,NC0.5,Fire Alarm\n";
+
+static double now_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// printf is the bottleneck at millions of lines per second: fixed formats written by hand
+static char *put_ulong(char *p, unsigned long v) {
+    char digits[20];
+    int n = 0;
+    do {
+        digits[n++] = (char)('0' + v % 10);
+        v /= 10;
+    } while (v);
+    while (n) *p++ = digits[--n];
+    return p;
+}
+
+static char *put_long(char *p, long v) {
+    if (v < 0) {
+        *p++ = '-';
+        return put_ulong(p, (unsigned long)-v);
+    }
+    return put_ulong(p, (unsigned long)v);
+}
+
+static char *put_fixed2(char *p, float v) {
+    long hundredths = (long)(v * 100.0f + (v < 0 ? -0.5f : 0.5f));
+    if (hundredths < 0) {
+        *p++ = '-';
+        hundredths = -hundredths;
+    }
+    p = put_ulong(p, (unsigned long)(hundredths / 100));
+    *p++ = '.';
+    *p++ = (char)('0' + hundredths / 10 % 10);
+    *p++ = (char)('0' + hundredths % 10);
+    return p;
+}
+
+static char *put_line(char *p, const sensor_fleet *fleet, int i, unsigned long utc) {
+    p = put_ulong(p, (unsigned long)i);     *p++ = ',';
+    p = put_ulong(p, utc);                  *p++ = ',';
+    p = put_fixed2(p, fleet->temperature[i]); *p++ = ',';
+    p = put_fixed2(p, fleet->humidity[i]);  *p++ = ',';
+    p = put_long(p, fleet->tvoc[i]);        *p++ = ',';
+    p = put_long(p, fleet->raw_h2[i]);      *p++ = ',';
+    p = put_long(p, fleet->raw_ethanol[i]); *p++ = ',';
+    p = put_fixed2(p, fleet->pressure[i]);  *p++ = ',';
+    p = put_long(p, fleet->pm1_0[i]);       *p++ = ',';
+    p = put_long(p, fleet->pm2_5[i]);       *p++ = ',';
+    p = put_long(p, fleet->nc0_5[i]);       *p++ = ',';
+    *p++ = (fleet->episodes[i] & SENSOR_FLEET_FIRE) ? '1' : '0';
+    *p++ = '\n';
+    return p;
+}
+
+static bool same_sensors(const sensor_sim_t *a, const sensor_sim_t *b) {
+    return a->temperature == b->temperature && a->humidity == b->humidity && a->pressure == b->pressure &&
+           a->tvoc == b->tvoc && a->raw_h2 == b->raw_h2 && a->raw_ethanol == b->raw_ethanol &&
+           a->pm1_0 == b->pm1_0 && a->pm2_5 == b->pm2_5 && a->nc0_5 == b->nc0_5 &&
+           a->fire_recovery_count == b->fire_recovery_count &&
+           a->hazard_recovery_count == b->hazard_recovery_count && a->rng == b->rng;
+}
+
+static void usage(const char *name) {
+    fprintf(stderr, "usage: %s [-n detectors] [-m measurements] [-f fire_p] [-z hazard_p] [-l episode_len]\n"
+                    "       [-s seed] [-p period_sec] [-o out.csv|-] [-c]\n", name);
+}
+
+int main(int argc, char **argv) {
+    int detectors = DEFAULT_DETECTORS;
+    int measurements = DEFAULT_MEASUREMENTS;
+    double fire_p = 0.0005, hazard_p = 0.0005;
+    int episode_len = DEFAULT_EPISODE_LEN;
+    uint32_t seed = SENSOR_SIM_DEFAULT_SEED;
+    unsigned long period = DEFAULT_PERIOD;
+    const char *out_path = NULL;
+    bool check = false;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "n:m:f:z:l:s:p:o:c")) != -1) {
+        switch (opt) {
+        case 'n': detectors = atoi(optarg); break;
+        case 'm': measurements = atoi(optarg); break;
+        case 'f': fire_p = atof(optarg); break;
+        case 'z': hazard_p = atof(optarg); break;
+        case 'l': episode_len = atoi(optarg); break;
+        case 's': seed = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'p': period = strtoul(optarg, NULL, 0); break;
+        case 'o': out_path = optarg; break;
+        case 'c': check = true; break;
+        default: usage(argv[0]); return 1;
+        }
+    }
+    if (detectors <= 0 || measurements <= 0) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    sensor_fleet fleet;
+    if (sensor_fleet_init(&fleet, detectors, seed) < 0) {
+        fprintf(stderr, "out of memory for %d detectors\n", detectors);
+        return 1;
+    }
+    sensor_fleet_set_episodes(&fleet, fire_p, hazard_p, episode_len);
+
+    FILE *out = NULL;
+    char *buffer = NULL;
+    if (out_path) {
+        out = strcmp(out_path, "-") ? fopen(out_path, "w") : stdout;
+        buffer = malloc(OUT_BUFFER_SIZE);
+        if (!out || !buffer) {
+            perror(out_path);
+            return 1;
+        }
+        fputs(header, out);
+    }
+
+    int checked = check ? (detectors < CHECKED_DETECTORS ? detectors : CHECKED_DETECTORS) : 0;
+    sensor_sim_t shadow[CHECKED_DETECTORS];
+    for (int i = 0; i < checked; i++) {
+        simulate_first_measurements(&shadow[i]);
+        sensor_sim_seed(&shadow[i], seed + (uint32_t)i);
+    }
+    long mismatches = 0;
+
+    double generate_s = 0.0;
+    unsigned long long bytes = 0;
+    double t0 = now_s();
+    for (int m = 0; m < measurements; m++) {
+        double g0 = now_s();
+        sensor_fleet_step(&fleet);
+        generate_s += now_s() - g0;
+
+        for (int i = 0; i < checked; i++) {
+            simulate_new_measurements(&shadow[i], fleet.episodes[i] & SENSOR_FLEET_FIRE, fleet.episodes[i] & SENSOR_FLEET_HAZARD);
+            sensor_sim_t s;
+            sensor_fleet_get(&fleet, i, &s);
+            mismatches += !same_sensors(&s, &shadow[i]);
+        }
+
+        if (out) {
+            unsigned long utc = TRACE_START + (unsigned long)m * period;
+            char *p = buffer;
+            for (int i = 0; i < detectors; i++) {
+                if (p - buffer > OUT_BUFFER_SIZE - MAX_LINE_LEN) {
+                    fwrite(buffer, 1, p - buffer, out);
+                    bytes += p - buffer;
+                    p = buffer;
+                }
+                p = put_line(p, &fleet, i, utc);
+            }
+            fwrite(buffer, 1, p - buffer, out);
+            bytes += p - buffer;
+        }
+    }
+    double elapsed_s = now_s() - t0;
+
+    double readings = (double)detectors * measurements;
+    fprintf(stderr, "fleet-load: %d detectors x %d measurements = %.0f readings, seed %u\n",
+            detectors, measurements, readings, (unsigned)seed);
+    fprintf(stderr, "  episodes     : %llu fire, %llu hazard (p %g / %g per measurement, %d measurements)\n",
+            (unsigned long long)fleet.fire_episodes, (unsigned long long)fleet.hazard_episodes,
+            fire_p, hazard_p, fleet.episode_len);
+    fprintf(stderr, "  simulation   : %.1f M readings/s (%.3f s)\n", readings / generate_s / 1e6, generate_s);
+    if (out) {
+        fprintf(stderr, "  with output  : %.1f M readings/s, %.1f MB/s (%.3f s, %llu bytes)\n",
+                readings / elapsed_s / 1e6, bytes / elapsed_s / 1e6, elapsed_s, bytes);
+        if (out != stdout) fclose(out);
+    }
+    if (checked) {
+        fprintf(stderr, "  check        : %ld mismatches vs sensor_sim over %d detectors\n", mismatches, checked);
+    }
+    free(buffer);
+    sensor_fleet_free(&fleet);
+    return (mismatches != 0);
+}
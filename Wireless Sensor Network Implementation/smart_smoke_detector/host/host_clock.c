@@ -0,0 +1,11 @@
+#include "os/sys/clock.h"
+
+static unsigned long host_seconds = 0;
+
+unsigned long clock_seconds(void) {
+    return host_seconds;
+}
+
+void host_clock_set(unsigned long seconds) {
+    host_seconds = seconds;
+}
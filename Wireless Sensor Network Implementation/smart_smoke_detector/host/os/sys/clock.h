@@ -0,0 +1,11 @@
+#ifndef HOST_CLOCK_H_
+#define HOST_CLOCK_H_
+
+/* Host-native stand-in for Contiki's os/sys/clock.h: lets lib/ sources build without Contiki.
+*  Time does not flow by itself, tools advance it with host_clock_set().
+*/
+unsigned long clock_seconds(void);
+
+void host_clock_set(unsigned long seconds);
+
+#endif /* HOST_CLOCK_H_ */
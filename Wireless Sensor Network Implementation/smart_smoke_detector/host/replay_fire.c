@@ -0,0 +1,99 @@
+/* Replay harness of the detector pipeline: fire_detected() (lib/fire_model.c) as built for the
+*  firmware, model and normalization switches included, fed with the rows of a sensor trace.
+*  Reports per-inference latency percentiles, throughput and, when the trace has a Fire Alarm
+*  column, the confusion matrix against it.
+*
+*    ./replay-fire [smoke_detection_iot.csv] [repetitions]
+*/
+#include "fire_dataset.h"
+#include "lib/fire_model.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define MAX_ROWS 80000
+#define SIM_ROWS 20000
+#define SIM_PHASE 200 // measurements per simulated phase
+#define DEFAULT_REPETITIONS 5
+
+static fire_sample samples[MAX_ROWS];
+static double latency[MAX_ROWS]; // ns
+static unsigned char decision[MAX_ROWS];
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static int compare_double(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+// nearest-rank percentile of sorted values
+static double percentile(const double *sorted, int n, double p) {
+    int rank = (int)(p / 100.0 * n + 0.5);
+    if (rank < 1) rank = 1;
+    if (rank > n) rank = n;
+    return sorted[rank - 1];
+}
+
+int main(int argc, char **argv) {
+    int n = (argc > 1) ? fire_dataset_load(argv[1], samples, MAX_ROWS) : fire_dataset_simulate(samples, SIM_ROWS, SIM_PHASE);
+    int repetitions = (argc > 2) ? atoi(argv[2]) : DEFAULT_REPETITIONS;
+    volatile int sink = 0;
+
+    if (n <= 0 || repetitions <= 0) {
+        return 1;
+    }
+
+    /* ---- per-inference latency (one timed pass, after a warm-up one) ---- */
+    for (int i = 0; i < n; i++) {
+        sink += fire_detected(&samples[i].sensors);
+    }
+    for (int i = 0; i < n; i++) {
+        double t0 = now_ns();
+        decision[i] = fire_detected(&samples[i].sensors);
+        latency[i] = now_ns() - t0;
+    }
+
+    /* ---- throughput (untimed calls) ---- */
+    double t0 = now_ns();
+    for (int r = 0; r < repetitions; r++) {
+        for (int i = 0; i < n; i++) {
+            sink += fire_detected(&samples[i].sensors);
+        }
+    }
+    double elapsed_s = (now_ns() - t0) / 1e9;
+
+    int tp = 0, fp = 0, fn = 0, tn = 0, labelled = 0, positives = 0;
+    for (int i = 0; i < n; i++) {
+        positives += decision[i];
+        if (samples[i].label < 0) continue;
+        labelled++;
+        if (decision[i]) {
+            if (samples[i].label) tp++; else fp++;
+        } else {
+            if (samples[i].label) fn++; else tn++;
+        }
+    }
+    qsort(latency, n, sizeof(latency[0]), compare_double);
+
+    printf("fire_detected() replay, %d rows (%s), model %s\n", n, (argc > 1) ? argv[1] : "sensor_sim", fire_model_name);
+    printf("  latency ns   : p50 %.0f  p90 %.0f  p99 %.0f  max %.0f\n",
+           percentile(latency, n, 50), percentile(latency, n, 90), percentile(latency, n, 99), latency[n - 1]);
+    printf("  throughput   : %.0f inferences/s (%d x %d calls)\n", (double)n * repetitions / elapsed_s, repetitions, n);
+    printf("  fire decided : %d/%d rows\n", positives, n);
+    if (labelled) {
+        printf("  confusion    :            alarm  no alarm\n");
+        printf("                 fire    %8d  %8d\n", tp, fp);
+        printf("                 no fire %8d  %8d\n", fn, tn);
+        printf("  accuracy %.2f%%  precision %.2f%%  recall %.2f%%  false alarms %.2f%%  (%d labelled rows)\n",
+               100.0 * (tp + tn) / labelled,
+               (tp + fp) ? 100.0 * tp / (tp + fp) : 0.0,
+               (tp + fn) ? 100.0 * tp / (tp + fn) : 0.0,
+               (fp + tn) ? 100.0 * fp / (fp + tn) : 0.0, labelled);
+    }
+    return (sink < 0);
+}
@@ -0,0 +1,185 @@
+#include "sensor_fleet.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+// same helpers of lib/sensor_sim.c, inlined in the loops
+static inline float clamp(float val, float min, float max) {
+    return (val < min) ? min : (val > max) ? max : val;
+}
+
+static inline int clamp_int(int val, int min, int max) {
+    return (val < min) ? min : (val > max) ? max : val;
+}
+
+static inline float step_towards(float current, float target, float step) {
+    if (fabsf(current - target) <= step) return target;
+    return current + (current < target ? step : -step);
+}
+
+static inline int step_towards_int(int current, int target, int step) {
+    if (abs(current - target) <= step) return target;
+    return current + (current < target ? step : -step);
+}
+
+int sensor_fleet_init(sensor_fleet *fleet, int n, uint32_t seed) {
+    memset(fleet, 0, sizeof(*fleet));
+    fleet->n = n;
+    fleet->temperature = malloc(n * sizeof(float));
+    fleet->humidity = malloc(n * sizeof(float));
+    fleet->pressure = malloc(n * sizeof(float));
+    fleet->tvoc = malloc(n * sizeof(int));
+    fleet->raw_h2 = malloc(n * sizeof(int));
+    fleet->raw_ethanol = malloc(n * sizeof(int));
+    fleet->pm1_0 = malloc(n * sizeof(int));
+    fleet->pm2_5 = malloc(n * sizeof(int));
+    fleet->nc0_5 = malloc(n * sizeof(int));
+    fleet->fire_recovery = calloc(n, 1);
+    fleet->hazard_recovery = calloc(n, 1);
+    fleet->fire_left = calloc(n, sizeof(uint16_t));
+    fleet->hazard_left = calloc(n, sizeof(uint16_t));
+    fleet->episodes = calloc(n, 1);
+    fleet->rng = malloc(n * sizeof(uint32_t));
+    if (!fleet->temperature || !fleet->humidity || !fleet->pressure || !fleet->tvoc || !fleet->raw_h2 ||
+        !fleet->raw_ethanol || !fleet->pm1_0 || !fleet->pm2_5 || !fleet->nc0_5 || !fleet->fire_recovery ||
+        !fleet->hazard_recovery || !fleet->fire_left || !fleet->hazard_left || !fleet->episodes || !fleet->rng) {
+        sensor_fleet_free(fleet);
+        return -1;
+    }
+
+    for (int i = 0; i < n; i++) {
+        sensor_sim_t s;
+        simulate_first_measurements(&s);
+        sensor_sim_seed(&s, seed + (uint32_t)i);
+        fleet->temperature[i] = s.temperature;
+        fleet->humidity[i] = s.humidity;
+        fleet->pressure[i] = s.pressure;
+        fleet->tvoc[i] = s.tvoc;
+        fleet->raw_h2[i] = s.raw_h2;
+        fleet->raw_ethanol[i] = s.raw_ethanol;
+        fleet->pm1_0[i] = s.pm1_0;
+        fleet->pm2_5[i] = s.pm2_5;
+        fleet->nc0_5[i] = s.nc0_5;
+        fleet->rng[i] = s.rng;
+    }
+    fleet->episode_rng = ~seed ? ~seed : SENSOR_SIM_DEFAULT_SEED;
+    fleet->episode_len = 1;
+    return 0;
+}
+
+void sensor_fleet_free(sensor_fleet *fleet) {
+    free(fleet->temperature);
+    free(fleet->humidity);
+    free(fleet->pressure);
+    free(fleet->tvoc);
+    free(fleet->raw_h2);
+    free(fleet->raw_ethanol);
+    free(fleet->pm1_0);
+    free(fleet->pm2_5);
+    free(fleet->nc0_5);
+    free(fleet->fire_recovery);
+    free(fleet->hazard_recovery);
+    free(fleet->fire_left);
+    free(fleet->hazard_left);
+    free(fleet->episodes);
+    free(fleet->rng);
+    memset(fleet, 0, sizeof(*fleet));
+}
+
+static uint32_t probability_threshold(double p) {
+    if (p <= 0.0) return 0;
+    if (p >= 1.0) return UINT32_MAX;
+    return (uint32_t)(p * 4294967296.0);
+}
+
+void sensor_fleet_set_episodes(sensor_fleet *fleet, double fire_p, double hazard_p, int episode_len) {
+    fleet->fire_threshold = probability_threshold(fire_p);
+    fleet->hazard_threshold = probability_threshold(hazard_p);
+    fleet->episode_len = (episode_len < 1) ? 1 : (episode_len > UINT16_MAX) ? UINT16_MAX : episode_len;
+}
+
+/* Field update of simulate_new_measurements for every detector: towards the episode value while
+*  the episode lasts, back towards the standard value while recovering, random walk otherwise
+*  (the only case drawing from the detector source).
+*/
+#define STEP_FLOAT_FIELD(field, left, recovery, episode, std, step, delta, min, max)          \
+    for (int i = 0; i < n; i++) {                                                              \
+        if (fleet->left[i]) {                                                                  \
+            fleet->field[i] = step_towards(fleet->field[i], episode, step);                    \
+        } else if (fleet->recovery[i]) {                                                       \
+            fleet->field[i] = step_towards(fleet->field[i], std, step);                        \
+        } else {                                                                               \
+            fleet->field[i] = clamp(fleet->field[i] + sensor_sim_delta(&fleet->rng[i], delta), min, max); \
+        }                                                                                      \
+    }
+
+#define STEP_INT_FIELD(field, left, recovery, episode, std, step, delta, min, max)            \
+    for (int i = 0; i < n; i++) {                                                              \
+        if (fleet->left[i]) {                                                                  \
+            fleet->field[i] = step_towards_int(fleet->field[i], episode, step);                \
+        } else if (fleet->recovery[i]) {                                                       \
+            fleet->field[i] = step_towards_int(fleet->field[i], std, step);                    \
+        } else {                                                                               \
+            fleet->field[i] = clamp_int(fleet->field[i] + sensor_sim_delta_int(&fleet->rng[i], delta), min, max); \
+        }                                                                                      \
+    }
+
+// recovery counters of simulate_new_measurements, then one measurement less in the episode
+static void step_counters(uint8_t *recovery, uint16_t *left, int n, int max_recovery) {
+    for (int i = 0; i < n; i++) {
+        if (left[i]) {
+            if (recovery[i] < max_recovery) recovery[i]++;
+            left[i]--;
+        } else if (recovery[i]) {
+            recovery[i]--;
+        }
+    }
+}
+
+static void start_episodes(sensor_fleet *fleet, uint16_t *left, uint32_t threshold, uint64_t *started) {
+    if (!threshold) return;
+    for (int i = 0; i < fleet->n; i++) {
+        if (!left[i] && sensor_sim_random(&fleet->episode_rng) < threshold) {
+            left[i] = fleet->episode_len;
+            (*started)++;
+        }
+    }
+}
+
+void sensor_fleet_step(sensor_fleet *fleet) {
+    int n = fleet->n;
+    start_episodes(fleet, fleet->fire_left, fleet->fire_threshold, &fleet->fire_episodes);
+    start_episodes(fleet, fleet->hazard_left, fleet->hazard_threshold, &fleet->hazard_episodes);
+    for (int i = 0; i < n; i++) {
+        fleet->episodes[i] = (fleet->fire_left[i] ? SENSOR_FLEET_FIRE : 0) | (fleet->hazard_left[i] ? SENSOR_FLEET_HAZARD : 0);
+    }
+
+    // field order of simulate_new_measurements: the detector sources are drawn in the same sequence
+    STEP_FLOAT_FIELD(temperature, fire_left, fire_recovery, TEMP_FIRE,     TEMP_STD,     TEMP_FIRE_STEP,     TEMP_DELTA,     TEMP_MIN,     TEMP_MAX)
+    STEP_FLOAT_FIELD(humidity,    fire_left, fire_recovery, HUMIDITY_FIRE, HUMIDITY_STD, HUMIDITY_FIRE_STEP, HUMIDITY_DELTA, HUMIDITY_MIN, HUMIDITY_MAX)
+    STEP_FLOAT_FIELD(pressure,    fire_left, fire_recovery, PRESSURE_FIRE, PRESSURE_STD, PRESSURE_FIRE_STEP, PRESSURE_DELTA, PRESSURE_MIN, PRESSURE_MAX)
+    STEP_INT_FIELD(tvoc,          fire_left, fire_recovery, TVOC_FIRE,     TVOC_STD,     TVOC_FIRE_STEP,     TVOC_DELTA,     TVOC_MIN,     TVOC_MAX)
+    STEP_INT_FIELD(raw_h2,        fire_left, fire_recovery, RAW_H2_FIRE,   RAW_H2_STD,   RAW_H2_FIRE_STEP,   RAW_H2_DELTA,   RAW_H2_MIN,   RAW_H2_MAX)
+    STEP_INT_FIELD(raw_ethanol,   fire_left, fire_recovery, RAW_ETH_FIRE,  RAW_ETH_STD,  RAW_ETH_FIRE_STEP,  RAW_ETH_DELTA,  RAW_ETH_MIN,  RAW_ETH_MAX)
+    STEP_INT_FIELD(pm1_0,   hazard_left, hazard_recovery, PM1_0_HAZARD, PM1_0_STD, PM1_0_HAZARD_STEP, PM1_0_DELTA, PM1_0_MIN, PM1_0_MAX)
+    STEP_INT_FIELD(pm2_5,   hazard_left, hazard_recovery, PM2_5_HAZARD, PM2_5_STD, PM2_5_HAZARD_STEP, PM2_5_DELTA, PM2_5_MIN, PM2_5_MAX)
+    STEP_INT_FIELD(nc0_5,   hazard_left, hazard_recovery, NC0_5_HAZARD, NC0_5_STD, NC0_5_HAZARD_STEP, NC0_5_DELTA, NC0_5_MIN, NC0_5_MAX)
+
+    step_counters(fleet->fire_recovery, fleet->fire_left, n, MAX_FIRE_RECOVERY_PERIOD);
+    step_counters(fleet->hazard_recovery, fleet->hazard_left, n, MAX_HAZARD_RECOVERY_PERIOD);
+}
+
+void sensor_fleet_get(const sensor_fleet *fleet, int i, sensor_sim_t *s) {
+    s->temperature = fleet->temperature[i];
+    s->humidity = fleet->humidity[i];
+    s->pressure = fleet->pressure[i];
+    s->tvoc = fleet->tvoc[i];
+    s->raw_h2 = fleet->raw_h2[i];
+    s->raw_ethanol = fleet->raw_ethanol[i];
+    s->pm1_0 = fleet->pm1_0[i];
+    s->pm2_5 = fleet->pm2_5[i];
+    s->nc0_5 = fleet->nc0_5[i];
+    s->fire_recovery_count = fleet->fire_recovery[i];
+    s->hazard_recovery_count = fleet->hazard_recovery[i];
+    s->rng = fleet->rng[i];
+}
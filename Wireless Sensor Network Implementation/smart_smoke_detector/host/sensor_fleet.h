@@ -0,0 +1,59 @@
+#ifndef SENSOR_FLEET_H
+#define SENSOR_FLEET_H
+
+#include <stdint.h>
+#include "lib/sensor_sim.h"
+
+/* Batch of independent virtual detectors, stepped together: the sensor_sim model
+*  (lib/sensor_sim.c) in structure-of-arrays layout, one array per field, so that a step is a
+*  few tight loops over contiguous values instead of one call per detector. Detector i is seeded
+*  with seed + i and draws from its own xorshift32 state, in the order simulate_new_measurements
+*  does: its readings are the ones of a sensor_sim_t with the same seed and episodes.
+*  Fire and hazard episodes start at random (per-measurement probability) and last episode_len
+*  measurements, then the values recover as in the firmware simulator.
+*/
+
+// episodes of the last measurement of a detector (sensor_fleet.episodes)
+#define SENSOR_FLEET_FIRE   0x01
+#define SENSOR_FLEET_HAZARD 0x02
+
+typedef struct {
+    int n;
+    float *temperature;
+    float *humidity;
+    float *pressure;
+    int *tvoc;
+    int *raw_h2;
+    int *raw_ethanol;
+    int *pm1_0;
+    int *pm2_5;
+    int *nc0_5;
+    uint8_t *fire_recovery;   // sensor_sim_t fire_recovery_count
+    uint8_t *hazard_recovery; // sensor_sim_t hazard_recovery_count
+    uint16_t *fire_left;      // measurements left in the current fire episode (0: none)
+    uint16_t *hazard_left;
+    uint8_t *episodes;        // SENSOR_FLEET_FIRE/HAZARD: is_fire/is_hazard of the last measurement
+    uint32_t *rng;
+
+    uint32_t episode_rng;     // episode starts, separate from the detectors' own sources
+    uint32_t fire_threshold;  // start probability per measurement, scaled to 2^32
+    uint32_t hazard_threshold;
+    uint16_t episode_len;
+    uint64_t fire_episodes;   // episodes started since init
+    uint64_t hazard_episodes;
+} sensor_fleet;
+
+// n detectors at the standard values, detector i seeded with seed + i. Returns -1 if out of memory
+int sensor_fleet_init(sensor_fleet *fleet, int n, uint32_t seed);
+void sensor_fleet_free(sensor_fleet *fleet);
+
+// per-measurement start probabilities of the episodes (0: none) and their length
+void sensor_fleet_set_episodes(sensor_fleet *fleet, double fire_p, double hazard_p, int episode_len);
+
+// one measurement of every detector
+void sensor_fleet_step(sensor_fleet *fleet);
+
+// detector i as a sensor_sim_t
+void sensor_fleet_get(const sensor_fleet *fleet, int i, sensor_sim_t *s);
+
+#endif // SENSOR_FLEET_H
@@ -0,0 +1,43 @@
+#include "lib/fire_features.h"
+#include "lib/sensor_table.h"
+#include <stddef.h> // for offsetof
+
+typedef struct {
+    uint16_t field;     // offset of the value in sensor_sim_t
+    senml_value_type type;
+    float mean;
+    float std_dev;
+    int8_t feature;     // -1: not a model input
+} feature_desc_t;
+
+// model input columns of the sensor table
+#define FEATURE_ROW(id, field, title, rt, unit, type, scale, offset, change, deadband, mean, sd, feature, limit, max) \
+  { offsetof(sensor_sim_t, field), type, mean, sd, feature },
+static const feature_desc_t feature_table[SENSOR_COUNT] = {
+  SENSOR_TABLE(FEATURE_ROW)
+};
+#undef FEATURE_ROW
+
+static float feature_value(const sensor_sim_t *sensors, const feature_desc_t *desc) {
+  const char *field = (const char *)sensors + desc->field;
+  if(desc->type == SENML_FLOAT) {
+    return *(const float *)field;
+  }
+  return (float)*(const int *)field;
+}
+
+void normalize_features(const sensor_sim_t *sensors, float *features) {
+  for(int i = 0; i < SENSOR_COUNT; i++) {
+    const feature_desc_t *d = &feature_table[i];
+    if(d->feature < 0) continue;
+    features[d->feature] = (feature_value(sensors, d) - d->mean) / d->std_dev;
+  }
+}
+
+void raw_features(const sensor_sim_t *sensors, float *features) {
+  for(int i = 0; i < SENSOR_COUNT; i++) {
+    const feature_desc_t *d = &feature_table[i];
+    if(d->feature < 0) continue;
+    features[d->feature] = feature_value(sensors, d);
+  }
+}
@@ -0,0 +1,18 @@
+#ifndef FIRE_FEATURES_H
+#define FIRE_FEATURES_H
+
+#include "lib/sensor_sim.h"
+
+/* Inputs of the fire detection model: the sensor table rows with a feature column
+*  (lib/sensor_table.h), in feature order.
+*/
+
+#define FIRE_MODEL_FEATURES 9 // inputs of the fire detection model
+
+// model input vector (FIRE_MODEL_FEATURES values) of the normalized sensed values
+void normalize_features(const sensor_sim_t *sensors, float *features);
+
+// model input vector of the sensed values as they are (normalization folded into the model)
+void raw_features(const sensor_sim_t *sensors, float *features);
+
+#endif // FIRE_FEATURES_H
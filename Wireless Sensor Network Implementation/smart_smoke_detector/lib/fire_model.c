@@ -0,0 +1,76 @@
+#include "lib/fire_model.h"
+
+/* ---------------- Model selection ---------------- */
+// the tree models are generated, not committed: only the header of the selected kind is needed
+#if FIRE_MODEL_KIND == FIRE_MODEL_TREE
+#if defined(__has_include) && !__has_include("fire_detector_tree.h")
+#error "tree model missing: make fire_detector_tree.h FIRE_DATASET=<kaggle csv>"
+#endif
+#include "fire_detector_tree.h"	// emlearn decision tree, tools/train_fire_models.py
+#define MODEL_NAME "tree (fire_detector_tree.h)"
+#define MODEL_INPUTS raw_features	// splits on raw values
+#define MODEL_PREDICT(features) fire_detector_tree_predict(features, FIRE_MODEL_FEATURES)
+
+#elif FIRE_MODEL_KIND == FIRE_MODEL_FOREST
+#if defined(__has_include) && !__has_include("fire_detector_forest.h")
+#error "forest model missing: make fire_detector_forest.h FIRE_DATASET=<kaggle csv>"
+#endif
+#include "fire_detector_forest.h"	// emlearn random forest, tools/train_fire_models.py
+#define MODEL_NAME "forest (fire_detector_forest.h)"
+#define MODEL_INPUTS raw_features	// splits on raw values
+#define MODEL_PREDICT(features) fire_detector_forest_predict(features, FIRE_MODEL_FEATURES)
+
+#elif FIRE_DETECTOR_QUANTIZED
+// generated and calibrated on the dataset, not committed
+#if defined(__has_include) && !__has_include("fire_detector_q.h")
+#error "quantized model missing: make fire_detector_q.h FIRE_DATASET=<kaggle csv>"
+#endif
+#include "fire_detector_q.h"	// int8/int16 model, tools/quantize_fire_detector.py
+#define MODEL_NAME "net, quantized (fire_detector_q.h)"
+#define MODEL_INPUTS normalize_features
+#define MODEL_PREDICT(features) fire_qnet_predict(&fire_detector_q, features, FIRE_MODEL_FEATURES)
+
+#elif FIRE_DETECTOR_FOLDED
+// generated and checked on the dataset, not committed
+#if defined(__has_include) && !__has_include("fire_detector_folded.h")
+#error "folded model missing: make fire_detector_folded.h FIRE_DATASET=<kaggle csv>"
+#endif
+#include "fire_detector_folded.h"	// normalization folded into layer 0, tools/fold_fire_detector.py
+#define MODEL_NAME "net, folded normalization (fire_detector_folded.h)"
+#define MODEL_INPUTS raw_features	// normalization is in the first layer
+#define MODEL_PREDICT(features) eml_net_predict(&fire_detector_folded, features, FIRE_MODEL_FEATURES)
+#define MODEL_EML_NET 1
+
+#else
+#include "fire_detector.h"	// emlearn generated model
+#define MODEL_NAME "net (fire_detector.h)"
+#define MODEL_INPUTS normalize_features
+#define MODEL_PREDICT(features) eml_net_predict(&fire_detector, features, FIRE_MODEL_FEATURES)
+#define MODEL_EML_NET 1
+#endif
+
+const char *const fire_model_name = MODEL_NAME;
+
+void fire_model_inputs(const sensor_sim_t *sensors, float *features) {
+  MODEL_INPUTS(sensors, features);
+}
+
+int32_t fire_model_predict(const float *features) {
+#ifdef MODEL_EML_NET
+  // This is needed to avoid compiler error (warnings == errors): unused static of eml_net.h
+  (void)eml_net_activation_function_strs;
+#endif
+  return MODEL_PREDICT(features);
+}
+
+bool fire_detected(const sensor_sim_t *s) {
+    // input vector
+    float features[FIRE_MODEL_FEATURES];
+    fire_model_inputs(s, features);
+
+    /*for (int i = 0; i < FIRE_MODEL_FEATURES; i++) {
+        printf("features[%d] = %f\n", i, features[i]);
+    }*/
+    /* ----------- invoke predictor ----------- */
+    return fire_model_predict(features) > 0;
+}
@@ -0,0 +1,39 @@
+#ifndef FIRE_MODEL_H
+#define FIRE_MODEL_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "lib/sensor_sim.h"
+#include "lib/fire_features.h"
+
+/* Fire detection model of the Smart Smoke Detector, selected at build time (make FIRE_MODEL=...):
+*  - net (default): emlearn MLP
+*      normalized inputs (fire_detector.h), FIRE_DETECTOR_FOLDED=0 (default)
+*      normalization folded into layer 0 (fire_detector_folded.h), FIRE_DETECTOR_FOLDED=1
+*      int8/int16 on normalized inputs (fire_detector_q.h), FIRE_DETECTOR_QUANTIZED=1
+*  - tree: emlearn decision tree on raw inputs (fire_detector_tree.h)
+*  - forest: emlearn random forest on raw inputs (fire_detector_forest.h)
+*  The tree models are generated by tools/train_fire_models.py.
+*  Inputs: lib/fire_features.h. Built without Contiki too (host/replay-fire).
+*/
+
+#define FIRE_MODEL_NET    0
+#define FIRE_MODEL_TREE   1
+#define FIRE_MODEL_FOREST 2
+
+#ifndef FIRE_MODEL_KIND
+#define FIRE_MODEL_KIND FIRE_MODEL_NET
+#endif
+
+extern const char *const fire_model_name;
+
+// input vector of the selected model (raw or normalized sensed values)
+void fire_model_inputs(const sensor_sim_t *sensors, float *features);
+
+// class of the selected model (1: fire) for a FIRE_MODEL_FEATURES input vector
+int32_t fire_model_predict(const float *features);
+
+// positive output of the model (probability > 0.5)
+bool fire_detected(const sensor_sim_t *sensors);
+
+#endif // FIRE_MODEL_H
@@ -0,0 +1,61 @@
+#include "lib/fire_qnet.h"
+
+static int16_t saturate16(int32_t v) {
+  if(v > INT16_MAX) return INT16_MAX;
+  if(v < INT16_MIN) return INT16_MIN;
+  return (int16_t)v;
+}
+
+// float -> Q<frac_bits>, round half up (as the generator models it)
+static int16_t quantize_input(float x, uint8_t frac_bits) {
+  float scaled = x * (float)(1L << frac_bits) + 0.5f;
+  if(scaled >= (float)INT16_MAX) return INT16_MAX;
+  if(scaled <= (float)INT16_MIN) return INT16_MIN;
+  int32_t v = (int32_t)scaled;
+  if((float)v > scaled) v--; // floor for negative values
+  return (int16_t)v;
+}
+
+static int32_t layer_accumulate(const fire_qnet_layer *layer, const int16_t *in, int o) {
+  const int8_t *w = layer->weights + o;
+  int32_t acc = layer->biases[o];
+  for(int i = 0; i < layer->n_inputs; i++) {
+    acc += (int32_t)in[i] * w[0];
+    w += layer->n_outputs;
+  }
+  return acc;
+}
+
+// every layer but the last one: int16 in, int16 out
+static void layer_forward(const fire_qnet_layer *layer, const int16_t *in, int16_t *out) {
+  int32_t half = layer->shift ? (1L << (layer->shift - 1)) : 0;
+  for(int o = 0; o < layer->n_outputs; o++) {
+    int32_t acc = layer_accumulate(layer, in, o);
+    if(layer->activation == FIRE_QNET_RELU && acc < 0) {
+      acc = 0;
+    }
+    out[o] = saturate16((acc + half) >> layer->shift);
+  }
+}
+
+int32_t fire_qnet_score(const fire_qnet *net, const float *features, int32_t n_features) {
+  int16_t *in = net->activations1;
+  int16_t *out = net->activations2;
+  for(int i = 0; i < n_features; i++) {
+    in[i] = quantize_input(features[i], net->input_frac_bits);
+  }
+  for(int l = 0; l < net->n_layers - 1; l++) {
+    layer_forward(&net->layers[l], in, out);
+    int16_t *tmp = in;
+    in = out;
+    out = tmp;
+  }
+  return layer_accumulate(&net->layers[net->n_layers - 1], in, 0);
+}
+
+int32_t fire_qnet_predict(const fire_qnet *net, const float *features, int32_t n_features) {
+  if(n_features != net->layers[0].n_inputs) {
+    return -1;
+  }
+  return fire_qnet_score(net, features, n_features) > 0 ? 1 : 0;
+}
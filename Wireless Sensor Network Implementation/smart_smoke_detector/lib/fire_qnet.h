@@ -0,0 +1,44 @@
+#ifndef FIRE_QNET_H
+#define FIRE_QNET_H
+
+#include <stdint.h>
+
+/* Integer inference of a quantized multi-layer perceptron (fire_detector_q.h, generated by
+*  tools/quantize_fire_detector.py from the emlearn fire_detector.h model):
+*  - weights int8 in Q<w>, biases int32 in the Q<w + a> of the layer accumulator
+*  - activations int16 in Q<a>, one format per layer input
+*  Each layer accumulates in int32 and shifts right by `shift` (with rounding) into the format
+*  of the next layer input. The weight layout is the emlearn one: weights[o + i * n_outputs].
+*  The last layer is logistic: the class is the sign of its accumulator (sigmoid(z) > 0.5).
+*/
+
+typedef enum {
+    FIRE_QNET_IDENTITY = 0,
+    FIRE_QNET_RELU,
+    FIRE_QNET_LOGISTIC, // output layer only
+} fire_qnet_activation;
+
+typedef struct {
+    int16_t n_outputs;
+    int16_t n_inputs;
+    const int8_t *weights;
+    const int32_t *biases;
+    uint8_t shift;      // accumulator -> next layer input format
+    fire_qnet_activation activation;
+} fire_qnet_layer;
+
+typedef struct {
+    int16_t n_layers;
+    const fire_qnet_layer *layers;
+    uint8_t input_frac_bits; // Q format of the (normalized) features
+    int16_t *activations1;   // both as large as the widest layer
+    int16_t *activations2;
+} fire_qnet;
+
+// features: normalized model inputs, as for eml_net_predict(). Returns the class (0/1), -1 on size mismatch
+int32_t fire_qnet_predict(const fire_qnet *net, const float *features, int32_t n_features);
+
+// accumulator of the single output of the last layer, in Q<w + a> of that layer
+int32_t fire_qnet_score(const fire_qnet *net, const float *features, int32_t n_features);
+
+#endif // FIRE_QNET_H
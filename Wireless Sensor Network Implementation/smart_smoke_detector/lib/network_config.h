@@ -5,6 +5,7 @@
 #define MAX_PAYLOAD_LEN 256
 
 // max number of measurements within each payload
+// (sensor payloads are streamed with Block2, so this is not bounded by REST_MAX_CHUNK_SIZE)
 
 #define PAYLOAD_MAX_MEASUREMENTS 6
 
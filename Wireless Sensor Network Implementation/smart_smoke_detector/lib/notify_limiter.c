@@ -0,0 +1,105 @@
+#include "lib/notify_limiter.h"
+#include "contiki.h"
+#include "sys/ctimer.h"
+#include "lib/virtual_clock.h"
+
+typedef struct {
+    coap_resource_t *resource;
+    clock_time_t last_sent;
+    bool pending;
+} notify_slot_t;
+
+static notify_slot_t slots[NOTIFY_LIMITER_SLOTS];
+static notify_limiter_stats_t stats;
+static struct ctimer flush_timer;
+static bool flush_armed = false;
+
+static notify_slot_t *slot_of(coap_resource_t *resource) {
+  for(int i = 0; i < NOTIFY_LIMITER_SLOTS; i++) {
+    if(slots[i].resource == resource) {
+      return &slots[i];
+    }
+    if(slots[i].resource == NULL) {
+      slots[i].resource = resource;
+      slots[i].last_sent = vclock_time() - NOTIFY_MIN_GAP; // first notification is not delayed
+      slots[i].pending = false;
+      return &slots[i];
+    }
+  }
+  return NULL;
+}
+
+static void send(notify_slot_t *slot, clock_time_t now) {
+  slot->pending = false;
+  slot->last_sent = now;
+  stats.sent++;
+  coap_notify_observers(slot->resource);
+}
+
+static void flush(void *ptr);
+
+// arm the timer at the earliest gap expiry of the pending slots
+static void schedule_flush(clock_time_t now) {
+  clock_time_t wait = NOTIFY_MIN_GAP;
+  bool any = false;
+  for(int i = 0; i < NOTIFY_LIMITER_SLOTS && slots[i].resource; i++) {
+    if(!slots[i].pending) continue;
+    clock_time_t elapsed = now - slots[i].last_sent;
+    clock_time_t left = (elapsed >= NOTIFY_MIN_GAP) ? 0 : NOTIFY_MIN_GAP - elapsed;
+    if(!any || left < wait) wait = left;
+    any = true;
+  }
+  if(any) {
+    ctimer_set(&flush_timer, wait ? wait : 1, flush, NULL);
+  }
+  flush_armed = any;
+}
+
+static void flush(void *ptr) {
+  (void)ptr;
+  clock_time_t now = vclock_time();
+  for(int i = 0; i < NOTIFY_LIMITER_SLOTS && slots[i].resource; i++) {
+    if(slots[i].pending && now - slots[i].last_sent >= NOTIFY_MIN_GAP) {
+      send(&slots[i], now);
+    }
+  }
+  schedule_flush(now);
+}
+
+void notify_limiter_request(coap_resource_t *resource) {
+  clock_time_t now = vclock_time();
+  notify_slot_t *slot = slot_of(resource);
+  stats.requested++;
+
+  if(!slot) {
+    stats.dropped++;
+    coap_notify_observers(resource);
+    return;
+  }
+  if(slot->pending) {
+    stats.coalesced++;
+  } else if(now - slot->last_sent >= NOTIFY_MIN_GAP) {
+    send(slot, now);
+  } else {
+    slot->pending = true;
+    stats.delayed++;
+    if(!flush_armed) {
+      schedule_flush(now);
+    }
+  }
+}
+
+void notify_limiter_bypass(coap_resource_t *resource) {
+  stats.bypassed++;
+  coap_notify_observers(resource);
+}
+
+void notify_limiter_poll(void) {
+  if(flush_armed) {
+    flush(NULL);
+  }
+}
+
+const notify_limiter_stats_t *notify_limiter_stats(void) {
+  return &stats;
+}
@@ -0,0 +1,46 @@
+#ifndef NOTIFY_LIMITER_H
+#define NOTIFY_LIMITER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "coap-engine.h"
+
+/* Rate limiting and coalescing of observe notifications:
+*  a resource is notified at most once every NOTIFY_MIN_GAP. A notification requested within the
+*  gap is kept pending and sent when the gap expires; further requests meanwhile are coalesced
+*  into it. The notification is built when sent, so the latest state wins.
+*  Notifications of a resource go to all of its observers at once (coap_notify_observers), so
+*  the limit applies per resource and, through it, per observer of that resource.
+*  Critical resources (status) bypass the limiter with notify_limiter_bypass().
+*/
+
+#ifndef NOTIFY_MIN_GAP
+#define NOTIFY_MIN_GAP (2 * CLOCK_SECOND) // minimum time between two notifications of a resource
+#endif
+
+#ifndef NOTIFY_LIMITER_SLOTS
+#define NOTIFY_LIMITER_SLOTS 12 // limited resources (sensors and /all)
+#endif
+
+typedef struct {
+    uint32_t requested;  // notify_limiter_request() calls
+    uint32_t sent;       // notifications sent through the limiter
+    uint32_t delayed;    // requests kept pending for the gap
+    uint32_t coalesced;  // requests merged into an already pending notification
+    uint32_t bypassed;   // critical notifications sent right away
+    uint32_t dropped;    // requests for a resource without a free slot, sent right away
+} notify_limiter_stats_t;
+
+// notify the observers of resource, now or when its gap expires
+void notify_limiter_request(coap_resource_t *resource);
+
+// sends the pending notifications whose gap expired (the flush timer does it in real time,
+// the detector loop calls it after advancing the virtual clock, lib/virtual_clock.h)
+void notify_limiter_poll(void);
+
+// notify the observers of a critical resource right away
+void notify_limiter_bypass(coap_resource_t *resource);
+
+const notify_limiter_stats_t *notify_limiter_stats(void);
+
+#endif // NOTIFY_LIMITER_H
@@ -0,0 +1,24 @@
+#include "lib/notify_policy.h"
+
+void notify_policy_init(notify_policy_t *policy, int32_t deadband, uint16_t max_interval) {
+  policy->deadband = deadband;
+  policy->max_interval = max_interval;
+  policy->notified = false;
+  policy->last_value = 0;
+  policy->last_time = 0;
+}
+
+bool notify_policy_due(notify_policy_t *policy, long value, unsigned long now) {
+  long delta = value - policy->last_value;
+  if(delta < 0) delta = -delta;
+
+  bool due = !policy->notified
+             || delta > policy->deadband
+             || (policy->max_interval > 0 && now - policy->last_time >= policy->max_interval);
+  if(due) {
+    policy->notified = true;
+    policy->last_value = value;
+    policy->last_time = now;
+  }
+  return due;
+}
@@ -0,0 +1,36 @@
+#ifndef NOTIFY_POLICY_H
+#define NOTIFY_POLICY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Observe notification policy of a sensor resource:
+*  - deadband: notify when the value moved by more than `deadband` (payload units: floats * 100)
+*    from the last notified one, or when `max_interval` seconds passed since the last notification.
+*    The reference is the last notified value, so a reading oscillating within the band is not
+*    notified again (hysteresis).
+*  - cycle (deadband < 0): notify at the end of every buffer cycle, as the series fills its window
+*  Configured with POST/PUT deadband=<d>&max_interval=<sec> on the resource.
+*/
+
+#ifndef NOTIFY_MAX_INTERVAL_DEFAULT
+#define NOTIFY_MAX_INTERVAL_DEFAULT 60 // sec
+#endif
+#define NOTIFY_MAX_INTERVAL_LIMIT 3600 // highest settable max_interval, sec
+
+#define NOTIFY_POLICY_CYCLE (-1) // deadband of the buffer cycle policy
+
+typedef struct {
+    int32_t deadband;       // payload units, NOTIFY_POLICY_CYCLE: buffer cycle policy
+    uint16_t max_interval;  // sec, 0: no periodic notification
+    bool notified;          // last_value/last_time valid
+    long last_value;
+    unsigned long last_time;
+} notify_policy_t;
+
+void notify_policy_init(notify_policy_t *policy, int32_t deadband, uint16_t max_interval);
+
+// deadband policy only: true if value (payload units) sensed at now must be notified, and records it
+bool notify_policy_due(notify_policy_t *policy, long value, unsigned long now);
+
+#endif // NOTIFY_POLICY_H
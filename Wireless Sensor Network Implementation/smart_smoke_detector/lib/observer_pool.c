@@ -0,0 +1,131 @@
+#include "lib/observer_pool.h"
+#include "contiki.h"
+#include "coap-observe.h"
+#include "lib/list.h"
+#include "sys/log.h"
+#include <stdbool.h>
+#include <string.h>
+
+#define LOG_MODULE "SSD-Obs"
+#define LOG_LEVEL LOG_LEVEL_APP
+
+#if OBSERVER_POOL_SIZE != COAP_MAX_OBSERVERS
+#error "COAP_MAX_OBSERVERS must be OBSERVER_POOL_SIZE (project-conf.h)"
+#endif
+
+// last time each observing client was heard from, least recent first out
+typedef struct {
+    coap_endpoint_t endpoint;
+    clock_time_t seen;
+    bool used;
+} pool_client_t;
+
+static pool_client_t clients[OBSERVER_POOL_SIZE];
+static observer_pool_stats_t stats;
+
+static void client_seen(const coap_endpoint_t *endpoint, clock_time_t now) {
+  pool_client_t *slot = &clients[0];
+  for(int i = 0; i < OBSERVER_POOL_SIZE; i++) {
+    if(clients[i].used && coap_endpoint_cmp(&clients[i].endpoint, endpoint)) {
+      clients[i].seen = now;
+      return;
+    }
+    if(!clients[i].used) {
+      slot = &clients[i];
+    } else if(slot->used && clients[i].seen < slot->seen) {
+      slot = &clients[i]; // stalest client, replaced if there is no free slot
+    }
+  }
+  coap_endpoint_copy(&slot->endpoint, endpoint);
+  slot->seen = now;
+  slot->used = true;
+}
+
+// 0 for clients not heard from since their entry was replaced: evicted first
+static clock_time_t client_last_seen(const coap_endpoint_t *endpoint) {
+  for(int i = 0; i < OBSERVER_POOL_SIZE; i++) {
+    if(clients[i].used && coap_endpoint_cmp(&clients[i].endpoint, endpoint)) {
+      return clients[i].seen;
+    }
+  }
+  return 0;
+}
+
+static bool is_pinned(const coap_observer_t *o) {
+  return strcmp(o->url, OBSERVER_POOL_PINNED) == 0;
+}
+
+/* the engine handles the Observe option after the resource handler: without it, a rejected
+*  registration is served as a plain GET instead of a 5.03 (the engine cannot add the observer)
+*/
+static void clear_observe_option(coap_message_t *request) {
+  request->options[COAP_OPTION_OBSERVE / COAP_OPTION_MAP_SIZE] &= ~(1 << (COAP_OPTION_OBSERVE % COAP_OPTION_MAP_SIZE));
+}
+
+int observer_pool_used(int *pinned) {
+  int used = 0;
+  if(pinned) {
+    *pinned = 0;
+  }
+  for(coap_observer_t *o = list_head(coap_get_observers()); o; o = o->next) {
+    used++;
+    if(pinned && is_pinned(o)) {
+      (*pinned)++;
+    }
+  }
+  return used;
+}
+
+void observer_pool_admit(coap_message_t *request) {
+  uint32_t observe;
+  const coap_endpoint_t *src = coap_get_src_endpoint(request);
+  if(!src) {
+    return;
+  }
+  clock_time_t now = clock_time();
+  client_seen(src, now);
+  if(!coap_get_header_observe(request, &observe) || observe != 0) {
+    return; // not a registration
+  }
+  stats.registrations++;
+
+  const char *url = NULL;
+  int url_len = coap_get_header_uri_path(request, &url);
+  coap_observer_t *victim = NULL;
+  clock_time_t victim_seen = 0;
+  int used = 0;
+  for(coap_observer_t *o = list_head(coap_get_observers()); o; o = o->next) {
+    used++;
+    if(coap_endpoint_cmp(&o->endpoint, src) && strncmp(o->url, url, url_len) == 0 && o->url[url_len] == '\0') {
+      return; // re-registration: the engine replaces the observer in its slot
+    }
+    if(is_pinned(o)) {
+      continue;
+    }
+    clock_time_t seen = client_last_seen(&o->endpoint);
+    if(!victim || seen < victim_seen) {
+      victim = o;
+      victim_seen = seen;
+    }
+  }
+  if(used < OBSERVER_POOL_SIZE) {
+    if(used + 1 > stats.peak) {
+      stats.peak = used + 1;
+    }
+    return;
+  }
+  if(victim) {
+    LOG_INFO("Observer pool full: evicting /%s observer\n", victim->url);
+    coap_remove_observer(victim);
+    stats.evicted++;
+  } else {
+    LOG_WARN("Observer pool full of /%s observers: registration to /%.*s rejected\n",
+             OBSERVER_POOL_PINNED, url_len, url);
+    clear_observe_option(request);
+    stats.rejected++;
+  }
+}
+
+const observer_pool_stats_t *observer_pool_stats(void) {
+  return &stats;
+}
@@ -0,0 +1,38 @@
+#ifndef OBSERVER_POOL_H
+#define OBSERVER_POOL_H
+
+#include <stdint.h>
+#include "coap-engine.h"
+
+/* Admission of observe registrations into the Contiki-NG observer pool:
+*  the observers of all the resources share one pool of OBSERVER_POOL_SIZE entries
+*  (COAP_MAX_OBSERVERS, project-conf.h). When it is full, a new registration evicts the observer
+*  whose client was heard from least recently (registration or request, the engine does not report
+*  the ACKs of CON notifications); /status observers are never evicted. A registration that
+*  finds the pool full of /status observers is rejected: its Observe option is removed, so it is
+*  served as a plain GET (without the Observe option) instead of the engine's 5.03.
+*  Observable GET handlers call observer_pool_admit() before the engine adds the observer.
+*/
+
+#ifndef OBSERVER_POOL_SIZE
+#define OBSERVER_POOL_SIZE 12 // ~80 bytes each (url, endpoint, token, refresh timer)
+#endif
+
+#define OBSERVER_POOL_PINNED "status" // resource whose observers are never evicted
+
+typedef struct {
+    uint32_t registrations; // observe registrations received (re-registrations included)
+    uint32_t evicted;       // observers removed to admit a registration
+    uint32_t rejected;      // registrations refused, pool full of pinned observers
+    uint16_t peak;          // most observers at once
+} observer_pool_stats_t;
+
+// called by observable GET handlers: no-op unless the request is an observe registration
+void observer_pool_admit(coap_message_t *request);
+
+// observers currently in the pool, and those of the pinned resource
+int observer_pool_used(int *pinned);
+
+const observer_pool_stats_t *observer_pool_stats(void);
+
+#endif // OBSERVER_POOL_H
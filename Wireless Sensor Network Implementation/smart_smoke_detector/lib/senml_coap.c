@@ -0,0 +1,146 @@
+#include "lib/senml_coap.h"
+#include "lib/stage_timing.h"
+#include <stdlib.h> // for atoi
+#include <string.h>
+#include <stdbool.h>
+
+// ?n=<m>, -1 (default window) if missing
+static int requested_measurements(coap_message_t *request) {
+  const char *n = NULL;
+  if(coap_get_query_variable(request, "n", &n)) {
+    return atoi(n);
+  }
+  return -1;
+}
+
+// true if the query contains 'flag' as a whole parameter, with or without a value (?stats, ?stats=1)
+static bool query_has_flag(coap_message_t *request, const char *flag) {
+  const char *query = NULL;
+  int query_len = coap_get_header_uri_query(request, &query);
+  int flag_len = strlen(flag);
+
+  for(int start = 0; start < query_len;) {
+    int end = start;
+    while(end < query_len && query[end] != '&') end++;
+    if(end - start >= flag_len && strncmp(query + start, flag, flag_len) == 0 &&
+       (end - start == flag_len || query[start + flag_len] == '=')) {
+      return true;
+    }
+    start = end + 1;
+  }
+  return false;
+}
+
+/* Content format of the response: SenML JSON without Accept or with Accept: 50, SenML-CBOR with
+*  Accept: 112 where 'cbor' is served, 0 for any other format (4.06 Not Acceptable)
+*/
+static unsigned int requested_content_format(coap_message_t *request, bool cbor) {
+  unsigned int accept;
+  if(!coap_get_header_accept(request, &accept) || accept == SENML_JSON_CONTENT_FORMAT) {
+    return SENML_JSON_CONTENT_FORMAT;
+  }
+  return (cbor && accept == SENML_CBOR_CONTENT_FORMAT) ? accept : 0;
+}
+
+static void set_not_acceptable(coap_message_t *response) {
+  coap_set_status_code(response, NOT_ACCEPTABLE_4_06);
+  coap_set_payload(response, "Unsupported Accept", 18);
+}
+
+/* Send the chunk [block_offset, block_offset + len) of a total_len bytes document already
+*  serialized into the CoAP buffer
+*/
+static void set_block_payload(coap_message_t *response, uint8_t *buffer, uint16_t preferred_size, int32_t *offset,
+                              unsigned int content_format, int32_t block_offset, int len, int32_t total_len) {
+  if(block_offset > 0 && block_offset >= total_len) {
+    coap_set_status_code(response, BAD_OPTION_4_02);
+    coap_set_payload(response, "Block out of scope", 18);
+    return;
+  }
+
+  coap_set_header_content_format(response, content_format);
+  coap_set_payload(response, buffer, len);
+
+  if(offset) {
+    // chunk-wise resource: the engine adds the Block2 option, -1 marks the last block
+    *offset = (block_offset + len < total_len) ? block_offset + len : -1;
+  } else if(total_len > len) {
+    // notification longer than one block: the observer fetches the rest with Block2 GETs
+    coap_set_header_block2(response, 0, 1, preferred_size);
+    coap_set_header_size2(response, total_len);
+  }
+}
+
+void senml_series_get_handler(const senml_series *series, coap_message_t *request, coap_message_t *response,
+                              uint8_t *buffer, uint16_t preferred_size, int32_t *offset) {
+  // offset is NULL for observe notifications: they always start from the first block
+  int32_t block_offset = offset ? *offset : 0;
+  int32_t total_len = 0;
+  int len;
+
+  // ?stats: running count/mean/variance/min/max since boot (SenML JSON)
+  if(query_has_flag(request, "stats")) {
+    if(requested_content_format(request, false) == 0) {
+      set_not_acceptable(response);
+      return;
+    }
+    STAGE_BEGIN(serialize, t_serialize);
+    len = senml_series_serialize_stats(series, buffer, preferred_size, block_offset, &total_len);
+    STAGE_END(serialize, t_serialize);
+    set_block_payload(response, buffer, preferred_size, offset, SENML_JSON_CONTENT_FORMAT, block_offset, len, total_len);
+    return;
+  }
+
+  int n_measurements = requested_measurements(request);
+
+  // ?res=1m|15m: min/max/avg rollup of the last n buckets instead of the raw measurements
+  const char *res = NULL;
+  int res_len = coap_get_query_variable(request, "res", &res);
+  unsigned int period = 0;
+  if(res_len > 0) {
+    if(res_len == 2 && strncmp(res, "1m", 2) == 0) {
+      period = SENML_ROLLUP_1M_PERIOD;
+    } else if(res_len == 3 && strncmp(res, "15m", 3) == 0) {
+      period = SENML_ROLLUP_15M_PERIOD;
+    } else {
+      coap_set_status_code(response, BAD_REQUEST_4_00);
+      coap_set_payload(response, "Unknown res", 11);
+      return;
+    }
+  }
+
+  // rollups are JSON only
+  unsigned int accept = requested_content_format(request, period == 0);
+  if(accept == 0) {
+    set_not_acceptable(response);
+    return;
+  }
+
+  STAGE_BEGIN(serialize, t_serialize);
+  if(period != 0) {
+    len = senml_series_serialize_rollup(series, period, n_measurements, buffer, preferred_size, block_offset, &total_len);
+  } else {
+    len = senml_series_serialize(series, accept, n_measurements, buffer, preferred_size, block_offset, &total_len);
+  }
+  STAGE_END(serialize, t_serialize);
+
+  set_block_payload(response, buffer, preferred_size, offset, accept, block_offset, len, total_len);
+}
+
+void senml_pack_get_handler(const senml_series *const series[], int n_series, coap_message_t *request,
+                            coap_message_t *response, uint8_t *buffer, uint16_t preferred_size, int32_t *offset) {
+  int n_measurements = requested_measurements(request);
+  unsigned int accept = requested_content_format(request, true);
+  if(accept == 0) {
+    set_not_acceptable(response);
+    return;
+  }
+
+  int32_t block_offset = offset ? *offset : 0;
+  int32_t total_len = 0;
+  STAGE_BEGIN(serialize, t_serialize);
+  int len = senml_pack_serialize(series, n_series, accept, n_measurements, buffer, preferred_size, block_offset, &total_len);
+  STAGE_END(serialize, t_serialize);
+
+  set_block_payload(response, buffer, preferred_size, offset, accept, block_offset, len, total_len);
+}
@@ -0,0 +1,22 @@
+#ifndef SENML_COAP_H
+#define SENML_COAP_H
+
+#include "coap-engine.h"
+#include "lib/senml_series.h"
+
+/* Shared GET handler of the sensor resources:
+*  ?n=<m> selects the last m measurements, Accept: 112 selects SenML-CBOR (SenML JSON otherwise),
+*  ?res=1m|15m returns the min/max/avg rollup of the last n buckets of that period (SenML JSON),
+*  ?stats the running count/mean/variance/min/max since boot (SenML JSON).
+*  The payload is serialized straight into the CoAP buffer, one Block2 chunk at a time.
+*/
+void senml_series_get_handler(const senml_series *series, coap_message_t *request, coap_message_t *response,
+                              uint8_t *buffer, uint16_t preferred_size, int32_t *offset);
+
+/* GET handler of a pack resource: the last n measurements of all the given series in one
+*  SenML pack with a shared base time (?n= and Accept as above, no rollups).
+*/
+void senml_pack_get_handler(const senml_series *const series[], int n_series, coap_message_t *request,
+                            coap_message_t *response, uint8_t *buffer, uint16_t preferred_size, int32_t *offset);
+
+#endif // SENML_COAP_H
@@ -0,0 +1,222 @@
+#include "lib/senml_cstore.h"
+#include <string.h> // for memset
+
+#define WINDOW_NONE 0xFF // no previous XOR window in the block
+
+// payload bits of the prefix codes 10, 110, 1110 (1111 is followed by 32 bits, 0 encodes zero)
+static const uint8_t bucket_bits[3] = { 7, 12, 20 };
+
+/* ---------------- Bit I/O (MSB first) ---------------- */
+
+// buf == NULL only counts the bits: used to check whether a sample fits the block
+static void put_bits(uint8_t *buf, uint16_t *bit_len, uint32_t value, uint8_t n) {
+    if (buf) {
+        for (uint8_t i = n; i > 0; i--) {
+            if ((value >> (i - 1)) & 1) {
+                buf[*bit_len >> 3] |= (uint8_t)(0x80 >> (*bit_len & 7));
+            }
+            (*bit_len)++;
+        }
+    } else {
+        *bit_len += n;
+    }
+}
+
+static uint32_t get_bits(const uint8_t *buf, uint16_t *bit, uint8_t n) {
+    uint32_t value = 0;
+    for (uint8_t i = 0; i < n; i++) {
+        value = (value << 1) | ((buf[*bit >> 3] >> (7 - (*bit & 7))) & 1);
+        (*bit)++;
+    }
+    return value;
+}
+
+/* ---------------- Prefix-coded signed integers ---------------- */
+
+static void put_signed(uint8_t *buf, uint16_t *bit_len, int32_t value) {
+    if (value == 0) {
+        put_bits(buf, bit_len, 0, 1);
+        return;
+    }
+    for (uint8_t i = 0; i < 3; i++) {
+        int32_t limit = (int32_t)1 << (bucket_bits[i] - 1);
+        if (value >= -limit && value < limit) {
+            put_bits(buf, bit_len, (1u << (i + 2)) - 2, i + 2); // 10, 110, 1110
+            put_bits(buf, bit_len, (uint32_t)value & ((1u << bucket_bits[i]) - 1), bucket_bits[i]);
+            return;
+        }
+    }
+    put_bits(buf, bit_len, 0xF, 4);
+    put_bits(buf, bit_len, (uint32_t)value, 32);
+}
+
+static int32_t get_signed(const uint8_t *buf, uint16_t *bit) {
+    uint8_t ones = 0;
+    while (ones < 4 && get_bits(buf, bit, 1)) {
+        ones++;
+    }
+    if (ones == 0) return 0;
+    if (ones == 4) return (int32_t)get_bits(buf, bit, 32);
+
+    uint8_t n = bucket_bits[ones - 1];
+    uint32_t raw = get_bits(buf, bit, n);
+    if (raw & (1u << (n - 1))) raw |= ~((1u << n) - 1); // sign extension
+    return (int32_t)raw;
+}
+
+/* ---------------- Sample codec ---------------- */
+
+// encode (time, value) after the sample described by state; buf == NULL only counts the bits
+static void encode_sample(uint8_t *buf, uint16_t *bit_len, senml_cstate *state, bool is_float,
+                          uint32_t time, uint32_t value) {
+    int32_t delta = (int32_t)(time - state->time);
+    put_signed(buf, bit_len, delta - state->delta);
+    state->time = time;
+    state->delta = delta;
+
+    if (!is_float) {
+        put_signed(buf, bit_len, (int32_t)(value - state->value));
+        state->value = value;
+        return;
+    }
+
+    uint32_t x = value ^ state->value;
+    state->value = value;
+    if (x == 0) {
+        put_bits(buf, bit_len, 0, 1);
+        return;
+    }
+
+    uint8_t leading = (uint8_t)__builtin_clz(x);
+    uint8_t trailing = (uint8_t)__builtin_ctz(x);
+    if (state->leading != WINDOW_NONE && leading >= state->leading && trailing >= state->trailing) {
+        // meaningful bits fall inside the previous window
+        put_bits(buf, bit_len, 2, 2); // 10
+        put_bits(buf, bit_len, x >> state->trailing, 32 - state->leading - state->trailing);
+    } else {
+        uint8_t meaningful = 32 - leading - trailing;
+        put_bits(buf, bit_len, 3, 2); // 11
+        put_bits(buf, bit_len, leading, 5);
+        put_bits(buf, bit_len, meaningful - 1, 5);
+        put_bits(buf, bit_len, x >> trailing, meaningful);
+        state->leading = leading;
+        state->trailing = trailing;
+    }
+}
+
+static void decode_sample(const uint8_t *buf, uint16_t *bit, senml_cstate *state, bool is_float) {
+    state->delta += get_signed(buf, bit);
+    state->time += (uint32_t)state->delta;
+
+    if (!is_float) {
+        state->value += (uint32_t)get_signed(buf, bit);
+        return;
+    }
+
+    if (get_bits(buf, bit, 1) == 0) return; // same value
+
+    if (get_bits(buf, bit, 1) == 1) {
+        state->leading = (uint8_t)get_bits(buf, bit, 5);
+        uint8_t meaningful = (uint8_t)get_bits(buf, bit, 5) + 1;
+        state->trailing = 32 - state->leading - meaningful;
+    }
+    uint8_t meaningful = 32 - state->leading - state->trailing;
+    state->value ^= get_bits(buf, bit, meaningful) << state->trailing;
+}
+
+static void start_block(senml_cstore *store, senml_cblock *block, uint32_t time, uint32_t value) {
+    memset(block->bits, 0, sizeof(block->bits));
+    block->first_time = time;
+    block->first_value = value;
+    block->bit_len = 0;
+    block->count = 1;
+
+    store->tail.time = time;
+    store->tail.delta = 0;
+    store->tail.value = value;
+    store->tail.leading = WINDOW_NONE;
+    store->tail.trailing = 0;
+}
+
+/* ---------------- Public API ---------------- */
+
+void senml_cstore_init(senml_cstore *store, bool is_float) {
+    store->oldest = 0;
+    store->used = 0;
+    store->size = 0;
+    store->is_float = is_float;
+}
+
+void senml_cstore_append(senml_cstore *store, uint32_t time, uint32_t value) {
+    if (store->used > 0) {
+        senml_cblock *newest = &store->blocks[(store->oldest + store->used - 1) % SENML_CSTORE_BLOCKS];
+
+        // dry run on a copy of the state: does the sample fit the newest block?
+        senml_cstate probe = store->tail;
+        uint16_t bit_len = newest->bit_len;
+        encode_sample(NULL, &bit_len, &probe, store->is_float, time, value);
+
+        if (bit_len <= SENML_CSTORE_BLOCK_BYTES * 8 && newest->count < UINT16_MAX) {
+            encode_sample(newest->bits, &newest->bit_len, &store->tail, store->is_float, time, value);
+            newest->count++;
+            store->size++;
+            return;
+        }
+    }
+
+    // new block, dropping the oldest one if the ring is full
+    if (store->used == SENML_CSTORE_BLOCKS) {
+        store->size -= store->blocks[store->oldest].count;
+        store->oldest = (store->oldest + 1) % SENML_CSTORE_BLOCKS;
+        store->used--;
+    }
+    start_block(store, &store->blocks[(store->oldest + store->used) % SENML_CSTORE_BLOCKS], time, value);
+    store->used++;
+    store->size++;
+}
+
+int senml_cstore_size(const senml_cstore *store) {
+    return store->size;
+}
+
+void senml_cstore_seek(const senml_cstore *store, int n, senml_cstore_cursor *cursor) {
+    cursor->store = store;
+    cursor->block = store->oldest;
+    cursor->pos = 0;
+
+    // skip whole blocks, then decode up to the requested sample
+    for (uint8_t b = 0; b + 1 < store->used && n >= store->blocks[cursor->block].count; b++) {
+        n -= store->blocks[cursor->block].count;
+        cursor->block = (cursor->block + 1) % SENML_CSTORE_BLOCKS;
+    }
+    uint32_t time, value;
+    while (n-- > 0) {
+        senml_cstore_next(cursor, &time, &value);
+    }
+}
+
+void senml_cstore_next(senml_cstore_cursor *cursor, uint32_t *time, uint32_t *value) {
+    const senml_cstore *store = cursor->store;
+    const senml_cblock *block = &store->blocks[cursor->block];
+
+    if (cursor->pos == block->count) {
+        cursor->block = (cursor->block + 1) % SENML_CSTORE_BLOCKS;
+        cursor->pos = 0;
+        block = &store->blocks[cursor->block];
+    }
+
+    if (cursor->pos == 0) {
+        cursor->state.time = block->first_time;
+        cursor->state.delta = 0;
+        cursor->state.value = block->first_value;
+        cursor->state.leading = WINDOW_NONE;
+        cursor->state.trailing = 0;
+        cursor->bit = 0;
+    } else {
+        decode_sample(block->bits, &cursor->bit, &cursor->state, store->is_float);
+    }
+    cursor->pos++;
+
+    *time = cursor->state.time;
+    *value = cursor->state.value;
+}
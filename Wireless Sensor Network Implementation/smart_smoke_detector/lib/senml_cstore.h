@@ -0,0 +1,72 @@
+#ifndef SENML_CSTORE_H
+#define SENML_CSTORE_H
+
+#include <stdint.h> // for uint32_t
+#include <stdbool.h> // for bool
+
+/* Compressed history of a senml_series (Gorilla-style):
+*  - timestamps: delta-of-delta, prefix-coded (1 bit when the sampling period is steady)
+*  - float values: XOR with the previous value, only the meaningful bits are kept
+*  - int values: delta with the previous value, prefix-coded
+*  Samples are appended to fixed-size blocks kept in a ring: when the ring is full the oldest
+*  block (and all its samples) is dropped. The first sample of each block is stored verbatim,
+*  so every block can be decoded on its own.
+*/
+
+// number of blocks of the ring
+#ifndef SENML_CSTORE_BLOCKS
+#define SENML_CSTORE_BLOCKS 4
+#endif
+
+// compressed bytes of each block
+#ifndef SENML_CSTORE_BLOCK_BYTES
+#define SENML_CSTORE_BLOCK_BYTES 32
+#endif
+
+typedef struct {
+    uint8_t bits[SENML_CSTORE_BLOCK_BYTES];
+    uint32_t first_time;
+    uint32_t first_value; // raw 32-bit pattern (float or int)
+    uint16_t bit_len;
+    uint16_t count;       // samples in the block, first one included
+} senml_cblock;
+
+// encoder/decoder running state
+typedef struct {
+    uint32_t time;
+    int32_t delta;
+    uint32_t value;
+    uint8_t leading;  // XOR window of the last float value
+    uint8_t trailing;
+} senml_cstate;
+
+typedef struct {
+    senml_cblock blocks[SENML_CSTORE_BLOCKS];
+    senml_cstate tail; // encoder state of the newest block
+    uint8_t oldest;    // ring index of the oldest block
+    uint8_t used;      // blocks holding samples
+    uint8_t is_float;
+    uint16_t size;     // samples retained
+} senml_cstore;
+
+typedef struct {
+    const senml_cstore *store;
+    senml_cstate state;
+    uint8_t block;     // ring index of the block being read
+    uint16_t pos;      // samples already read from the block
+    uint16_t bit;      // read position in the block
+} senml_cstore_cursor;
+
+void senml_cstore_init(senml_cstore *store, bool is_float);
+
+void senml_cstore_append(senml_cstore *store, uint32_t time, uint32_t value);
+
+int senml_cstore_size(const senml_cstore *store);
+
+// position the cursor so that the next read returns the n-th retained sample (0 = oldest)
+void senml_cstore_seek(const senml_cstore *store, int n, senml_cstore_cursor *cursor);
+
+// read the sample under the cursor and move to the following one
+void senml_cstore_next(senml_cstore_cursor *cursor, uint32_t *time, uint32_t *value);
+
+#endif // SENML_CSTORE_H
@@ -1,123 +1,843 @@
 #include "lib/senml_series.h"
 #include <stdio.h> // for snprintf
-#include "os/sys/clock.h"
-#include <locale.h>
+#include "lib/virtual_clock.h"
+#include <string.h> // for strlen, memcpy
 
-void init_measurements_series(senml_series *series, const char *name, const char *unit, senml_value_type type) {
+/* ---------------- History storage ---------------- */
+/* Measurements are read back in insertion order through a cursor, so the encoders do not depend
+*  on the storage layout (raw circular buffer or compressed block ring).
+*/
+
+// value as a raw 32-bit pattern
+typedef union {
+    float fvalue;
+    int32_t ivalue;
+    uint32_t bits;
+} senml_value;
+
+typedef struct {
+#if SENML_COMPRESSED_HISTORY
+    senml_cstore_cursor c;
+#else
+    const senml_series *series;
+    int idx;
+#endif
+} record_cursor;
+
+#if SENML_COMPRESSED_HISTORY
+
+static void history_init(senml_series *series) {
+    senml_cstore_init(&series->store, series->value_type == SENML_FLOAT);
+}
+
+// stores the measurement of the current timeline row, returns it as it will be read back
+static senml_value history_append(senml_series *series, senml_value value) {
+    senml_cstore_append(&series->store, series->timeline->now, value.bits);
+    return value;
+}
+
+// measurements retained
+static int history_size(const senml_series *series) {
+    return senml_cstore_size(&series->store);
+}
+
+// the next read returns the n-th retained measurement (0 = oldest)
+static void history_seek(const senml_series *series, int n, record_cursor *cursor) {
+    senml_cstore_seek(&series->store, n, &cursor->c);
+}
+
+static void history_next(record_cursor *cursor, unsigned long *time, senml_value *value) {
+    uint32_t t;
+    senml_cstore_next(&cursor->c, &t, &value->bits);
+    *time = t;
+}
+
+#else
+
+static void history_init(senml_series *series) {
+    series->scale = (series->value_type == SENML_FLOAT) ? 100.0f : 1.0f;
+    series->offset = 0;
+}
+
+static int16_t column_saturate(long value) {
+    if (value > INT16_MAX) return INT16_MAX;
+    if (value < INT16_MIN) return INT16_MIN;
+    return (int16_t)value;
+}
+
+static senml_value column_decode(const senml_series *series, int16_t stored) {
+    senml_value value;
+    if (series->value_type == SENML_FLOAT) {
+        value.fvalue = (float)stored / series->scale + (float)series->offset;
+    } else {
+        value.ivalue = (int32_t)stored + series->offset;
+    }
+    return value;
+}
+
+// stores the measurement in the slot of the current timeline row, returns it as it will be read back
+static senml_value history_append(senml_series *series, senml_value value) {
+    int16_t stored;
+    if (series->value_type == SENML_FLOAT) {
+        float scaled = (value.fvalue - (float)series->offset) * series->scale;
+        stored = column_saturate((long)(scaled + (scaled < 0 ? -0.5f : 0.5f)));
+    } else {
+        stored = column_saturate((long)value.ivalue - series->offset);
+    }
+    series->column[series->timeline->index] = stored;
+    return column_decode(series, stored);
+}
+
+// the columns keep the last SENML_HISTORY_DEPTH rows at most
+static int history_size(const senml_series *series) {
+    return (series->count < SENML_HISTORY_DEPTH) ? series->count : SENML_HISTORY_DEPTH;
+}
+
+/* the next read returns the n-th retained measurement (0 = oldest):
+*  the newest one is in the slot of the current timeline row
+*/
+static void history_seek(const senml_series *series, int n, record_cursor *cursor) {
+    int oldest_index = (series->timeline->index - history_size(series) + 1 + SENML_HISTORY_DEPTH) % SENML_HISTORY_DEPTH;
+    cursor->series = series;
+    cursor->idx = (oldest_index + n) % SENML_HISTORY_DEPTH;
+}
+
+static void history_next(record_cursor *cursor, unsigned long *time, senml_value *value) {
+    *value = column_decode(cursor->series, cursor->series->column[cursor->idx]);
+    *time = cursor->series->timeline->time[cursor->idx];
+    cursor->idx = (cursor->idx + 1) % SENML_HISTORY_DEPTH;
+}
+
+#endif /* SENML_COMPRESSED_HISTORY */
+
+// value as transmitted: floats are scaled by 100 (rounded) and sent as integers
+static long record_value(const senml_series *series, senml_value value) {
+    if (series->value_type == SENML_FLOAT) {
+        float scaled = value.fvalue * 100.0f;
+        return (long)(scaled + (scaled < 0 ? -0.5f : 0.5f));
+    }
+    return value.ivalue;
+}
+
+/* ---------------- Rollup tiers ---------------- */
+
+static void tier_init(senml_tier *tier) {
+    tier->newest_slot = 0;
+    tier->head = 0;
+    tier->used = 0;
+}
+
+static void bucket_start(senml_bucket *bucket) {
+    bucket->min = INT32_MAX;
+    bucket->max = INT32_MIN;
+    bucket->sum = 0;
+    bucket->count = 0;
+}
+
+// fold value into the bucket of 'time', opening new (possibly empty) buckets when time moves on
+static void tier_add(senml_tier *tier, senml_bucket *buckets, uint16_t slots, uint32_t period,
+                     unsigned long time, int32_t value) {
+    uint32_t slot = (uint32_t)(time / period);
+
+    if (tier->used == 0) {
+        tier->newest_slot = slot;
+        tier->head = 0;
+        tier->used = 1;
+        bucket_start(&buckets[0]);
+    } else if (slot > tier->newest_slot) {
+        // one bucket per elapsed period, periods without measurements stay empty
+        uint32_t elapsed = slot - tier->newest_slot;
+        if (elapsed > slots) elapsed = slots;
+        while (elapsed-- > 0) {
+            tier->head = (tier->head + 1) % slots;
+            if (tier->used < slots) tier->used++;
+            bucket_start(&buckets[tier->head]);
+        }
+        tier->newest_slot = slot;
+    } // a measurement older than the newest bucket (clock adjustment) is folded into it
+
+    senml_bucket *bucket = &buckets[tier->head];
+    if (value < bucket->min) bucket->min = value;
+    if (value > bucket->max) bucket->max = value;
+    bucket->sum += value;
+    if (bucket->count < UINT16_MAX) bucket->count++;
+}
+
+static void rollup_add(senml_series *series, unsigned long time, senml_value value) {
+    int32_t v = (int32_t)record_value(series, value);
+    tier_add(&series->tier_1m, series->buckets_1m, SENML_ROLLUP_1M_SLOTS, SENML_ROLLUP_1M_PERIOD, time, v);
+    tier_add(&series->tier_15m, series->buckets_15m, SENML_ROLLUP_15M_SLOTS, SENML_ROLLUP_15M_PERIOD, time, v);
+}
+
+/* ---------------- Running statistics ---------------- */
+
+static void stats_init(senml_stats *stats) {
+    stats->count = 0;
+    stats->mean = 0.0f;
+    stats->m2 = 0.0f;
+    stats->min = INT32_MAX;
+    stats->max = INT32_MIN;
+}
+
+// Welford update: numerically stable mean/variance in O(1) per sample
+static void stats_add(senml_series *series, senml_value value) {
+    senml_stats *stats = &series->stats;
+    int32_t v = (int32_t)record_value(series, value);
+    float delta = (float)v - stats->mean;
+
+    stats->count++;
+    stats->mean += delta / (float)stats->count;
+    stats->m2 += delta * ((float)v - stats->mean);
+    if (v < stats->min) stats->min = v;
+    if (v > stats->max) stats->max = v;
+}
+
+/* ---------------- Trend window ---------------- */
+
+static void trend_init(senml_trend *trend) {
+    trend->sum_y = 0;
+    trend->sum_xy = 0;
+    trend->oldest = 0;
+    trend->n = 0;
+}
+
+/* Sliding the window by one drops y_0 and renumbers the others x - 1:
+*    sum_xy' = sum_xy - (sum_y - y_0) + (n - 1) * y_new,  sum_y' = sum_y - y_0 + y_new
+*  integer sums, so no drift however long the series runs
+*/
+static void trend_add(senml_series *series, senml_value value) {
+    senml_trend *trend = &series->trend;
+    int32_t v = (int32_t)record_value(series, value);
+
+    if (trend->n < SENML_TREND_WINDOW) {
+        trend->window[(trend->oldest + trend->n) % SENML_TREND_WINDOW] = v;
+        trend->sum_xy += (int32_t)trend->n * v;
+        trend->sum_y += v;
+        trend->n++;
+        return;
+    }
+    int32_t y0 = trend->window[trend->oldest];
+    trend->sum_xy += y0 - trend->sum_y + (SENML_TREND_WINDOW - 1) * v;
+    trend->sum_y += v - y0;
+    trend->window[trend->oldest] = v;
+    trend->oldest = (trend->oldest + 1) % SENML_TREND_WINDOW;
+}
+
+
+void senml_timeline_init(senml_timeline *timeline) {
+    timeline->now = 0;
+    timeline->index = SENML_HISTORY_DEPTH - 1; // the first row goes in slot 0
+    timeline->count = 0;
+}
+
+void senml_timeline_advance(senml_timeline *timeline) {
+    timeline->now = (uint32_t)vclock_seconds();
+    timeline->index = (timeline->index + 1) % SENML_HISTORY_DEPTH;
+#if !SENML_COMPRESSED_HISTORY
+    timeline->time[timeline->index] = timeline->now;
+#endif
+    timeline->count++;
+}
+
+
+void init_measurements_series(senml_series *series, const senml_timeline *timeline,
+                              const char *name, const char *unit, senml_value_type type) {
     snprintf(series->name, NAME_MAX_LEN, "%s", name);
     snprintf(series->unit, UNIT_MAX_LEN, "%s", unit);
 
     series->value_type = type;
+    series->timeline = timeline;
     series->count = 0;
-    series->index = 0;
+    history_init(series);
+    tier_init(&series->tier_1m);
+    tier_init(&series->tier_15m);
+    stats_init(&series->stats);
+    trend_init(&series->trend);
+}
+
+void senml_series_set_scaling(senml_series *series, float scale, int32_t offset) {
+#if SENML_COMPRESSED_HISTORY
+    (void)series;
+    (void)scale;
+    (void)offset;
+#else
+    series->scale = scale;
+    series->offset = offset;
+#endif
+}
+
+// measurement of the current timeline row
+static void add_value(senml_series *series, senml_value value) {
+    senml_value stored = history_append(series, value);
+    rollup_add(series, series->timeline->now, stored);
+    stats_add(series, stored);
+    trend_add(series, stored);
+    series->count++;
 }
 
 void add_measurement(senml_series *series, float value) {
     if (series->value_type != SENML_FLOAT) return;
 
-    unsigned long now = clock_seconds();
-    series->records[series->index].fvalue = value;
-    series->records[series->index].time = now;
-    series->index = (series->index + 1) % HISTORY_SIZE;
-    series->count++;
+    senml_value v;
+    v.fvalue = value;
+    add_value(series, v);
 }
 
-// integer version for type-safe programming
 void add_measurement_int(senml_series *series, int value) {
     if (series->value_type != SENML_INT) return;
 
-    unsigned long now = clock_seconds();
-    series->records[series->index].ivalue = value;
-    series->records[series->index].time = now;
-    series->index = (series->index + 1) % HISTORY_SIZE;
-    series->count++;
+    senml_value v;
+    v.ivalue = value;
+    add_value(series, v);
 }
 
 bool is_buffer_cycle_complete(senml_series *series){
     return (series->count % HISTORY_SIZE == 0);
 }
 
-void create_senml_json(const senml_series *series, char *payload, unsigned int payload_size, int req_m) { //size_t = unsigned long
-    if (!series || series->count == 0) {
-        snprintf(payload, payload_size, "{\"bn\":\"%s\",\"ver\":%d,\"e\":[]}", BASE_NAME, VERSION);
-        return; // No measurements available yet
-    }
+/* ---------------- Streaming serialization ---------------- */
 
+static void writer_put(senml_writer *w, const void *data, unsigned int len) {
+    const uint8_t *src = (const uint8_t *)data;
+    int32_t data_pos = w->pos;
+    int32_t start = data_pos;
+    int32_t stop = data_pos + (int32_t)len;
+    w->pos = stop;
+
+    // clip [start, stop) to the output window
+    if (start < w->offset) start = w->offset;
+    if (stop > w->offset + (int32_t)w->size) stop = w->offset + (int32_t)w->size;
+    if (start >= stop) return;
+
+    memcpy(w->buf + (start - w->offset), src + (start - data_pos), stop - start);
+}
+
+static void writer_puts(senml_writer *w, const char *text) {
+    writer_put(w, text, strlen(text));
+}
+
+static int writer_written(const senml_writer *w) {
+    int32_t len = w->pos - w->offset;
+    if (len < 0) return 0;
+    return (len > (int32_t)w->size) ? (int)w->size : (int)len;
+}
+
+void senml_writer_init(senml_writer *w, uint8_t *buf, unsigned int size, int32_t offset) {
+    w->buf = buf;
+    w->size = size;
+    w->offset = offset;
+    w->pos = 0;
+}
+
+void senml_writer_put(senml_writer *w, const void *data, unsigned int len) {
+    writer_put(w, data, len);
+}
+
+void senml_writer_puts(senml_writer *w, const char *text) {
+    writer_puts(w, text);
+}
+
+int senml_writer_written(const senml_writer *w) {
+    return writer_written(w);
+}
+
+/* Determine how many measurements to include and open a cursor on the oldest one:
+*  req_m <= 0 gives the default window (last HISTORY_SIZE), larger requests are capped to the retained ones
+*/
+static int window_open(const senml_series *series, int req_m, record_cursor *cursor) {
     // Determine how many measurements are available
-    int available_m = (series->count < HISTORY_SIZE) ? series->count : HISTORY_SIZE;
+    int available_m = history_size(series);
+
+    // Decide how many measurements to include in the payload
+    int default_m = (available_m < HISTORY_SIZE) ? available_m : HISTORY_SIZE;
+    int actual_m = (req_m <= 0) ? default_m : ((req_m >= available_m) ? available_m : req_m);
+
+    history_seek(series, available_m - actual_m, cursor);
+    return actual_m;
+}
+
+/* ---------------- Fixed-point text emitters ---------------- */
+// hot path replacement of snprintf("%d"/"%lu"): no format parsing, no locale, no varargs
+
+// decimal digits of 'value' at 'out', returns the number of chars written (no terminator)
+static unsigned int fmt_ulong(char *out, unsigned long value) {
+    char digits[20]; // enough for a 64-bit unsigned long
+    unsigned int n = 0;
+    unsigned int len = 0;
+
+    do {
+        digits[n++] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value > 0);
+
+    while (n > 0) {
+        out[len++] = digits[--n];
+    }
+    return len;
+}
+
+static unsigned int fmt_long(char *out, long value) {
+    if (value < 0) {
+        out[0] = '-';
+        return 1 + fmt_ulong(out + 1, 0UL - (unsigned long)value);
+    }
+    return fmt_ulong(out, (unsigned long)value);
+}
+
+// 'value' rounded to two decimals: -12.34 (64-bit digits, variances of raw counts exceed 32 bits)
+static unsigned int fmt_fixed2(char *out, float value) {
+    char digits[20];
+    unsigned int n = 0;
+    unsigned int len = 0;
 
-    // Decide how many measurements to include in the JSON
-    int actual_m = (req_m <= 0 || req_m >= available_m) ? available_m : req_m;
+    if (value < 0) {
+        out[len++] = '-';
+        value = -value;
+    }
+    if (value > 1e17f) value = 1e17f; // keeps value * 100 within uint64_t
+    uint64_t hundredths = (uint64_t)(value * 100.0f + 0.5f);
+
+    do {
+        digits[n++] = (char)('0' + hundredths % 10);
+        hundredths /= 10;
+    } while (hundredths > 0 || n < 3); // at least "0.00"
+
+    while (n > 0) {
+        if (n == 2) out[len++] = '.';
+        out[len++] = digits[--n];
+    }
+    return len;
+}
+
+static unsigned int fmt_str(char *out, const char *text) {
+    unsigned int len = strlen(text);
+    memcpy(out, text, len);
+    return len;
+}
 
-    // Index of the newest record (most recent)
-    int newest_index = (series->index - 1 + HISTORY_SIZE) % HISTORY_SIZE;
+static void write_senml_json(const senml_series *series, int req_m, senml_writer *w) {
+    char entry[48]; // longest entry: ,{"v":-2147483648,"t":-2147483648}
+    unsigned int len;
 
-    /* Determine index of the oldest record to include, handling a circual buffer
-    * (actual_m-1): remember that one measurement (newest) is already included
-    * (actual_m-1) = -actual_m +1
-    * if actual_m == HISTORY_SIZE: 
-    *                (newest_index + 1 - HISTORY_SIZE + HISTORY_SIZE) % HISTORY_SIZE
-    *              = (newest_index + 1) % HISTORY_SIZE
-    *              = series->index                     // the next to be overwritten is oldest
-    */
-    // Index of the oldest record to include
-    int oldest_index = (newest_index - actual_m + 1 + HISTORY_SIZE) % HISTORY_SIZE;
+    if (series->count == 0) {
+        writer_puts(w, "{\"bn\":\"");
+        writer_puts(w, BASE_NAME);
+        len = fmt_str(entry, "\",\"ver\":");
+        len += fmt_long(entry + len, VERSION);
+        len += fmt_str(entry + len, ",\"e\":[]}");
+        writer_put(w, entry, len);
+        return; // No measurements available yet
+    }
+
+    record_cursor cursor;
+    int actual_m = window_open(series, req_m, &cursor);
 
     // Use the timestamp of the oldest record as base time
-    unsigned long base_time = series->records[oldest_index].time;
+    unsigned long time, base_time;
+    senml_value value;
+    history_next(&cursor, &base_time, &value);
+    time = base_time;
 
     // Begin the JSON payload
-    int written = snprintf(payload, payload_size,
-        "{\"bn\":\"%s%s\",\"bu\":\"%s\",\"ver\":%d,\"bt\":%lu,\"e\":[",
-        BASE_NAME, series->name, series->unit, VERSION, base_time);
-
-    setlocale(LC_NUMERIC, "C"); // guarantee snprintf %.3f as 123.456
-    
-    // Write each measurement as a SenML entry
-    for (int i = 0; i < actual_m && written < payload_size; i++) {
-        int idx = (oldest_index + i) % HISTORY_SIZE;
-        int rel_time = (int)(series->records[idx].time - base_time);
-
-        // Add comma separator for all but the first entry
-        if (i > 0) {
-            written += snprintf(payload + written, payload_size - written, ",");
-        }
+    writer_puts(w, "{\"bn\":\"");
+    writer_puts(w, BASE_NAME);
+    writer_puts(w, series->name);
+    writer_puts(w, "\",\"bu\":\"");
+    writer_puts(w, series->unit);
+    len = fmt_str(entry, "\",\"ver\":");
+    len += fmt_long(entry + len, VERSION);
+    len += fmt_str(entry + len, ",\"bt\":");
+    len += fmt_ulong(entry + len, base_time);
+    len += fmt_str(entry + len, ",\"e\":[");
+    writer_put(w, entry, len);
+
+    // Write each measurement as a SenML entry {"v":%d,"t":%d}, comma separated
+    for (int i = 0; i < actual_m; i++) {
+        if (i > 0) history_next(&cursor, &time, &value);
+        int rel_time = (int)(time - base_time);
+
+        len = 0;
+        if (i > 0) entry[len++] = ',';
+        len += fmt_str(entry + len, "{\"v\":");
+        len += fmt_long(entry + len, record_value(series, value));
+        len += fmt_str(entry + len, ",\"t\":");
+        len += fmt_long(entry + len, rel_time);
+        entry[len++] = '}';
+        writer_put(w, entry, len);
+    }
 
-        // Add the value entry depending on type
-        if (series->value_type == SENML_FLOAT) {
-            int value_int = (int)(series->records[idx].fvalue * 100.0f);
-            written += snprintf(payload + written, payload_size - written,
-            "{\"v\":%d,\"t\":%d}", value_int, rel_time);
-        } else if (series->value_type == SENML_INT) {
-            written += snprintf(payload + written, payload_size - written,
-                "{\"v\":%d,\"t\":%d}", series->records[idx].ivalue, rel_time);
+    // Close the JSON object
+    writer_puts(w, "]}");
+}
+
+/* Rollup payload, same header of the measurements one plus the bucket period "res" (sec):
+*    {"bn":..,"bu":..,"ver":1,"bt":<start of the oldest bucket>,"res":60,"e":[{"v":avg,"min":..,"max":..,"t":..},..]}
+*  buckets without measurements are skipped, "t" is the start of the bucket relative to bt
+*/
+static void write_rollup_json(const senml_series *series, const senml_tier *tier, const senml_bucket *buckets,
+                              uint16_t slots, uint32_t period, int req_m, senml_writer *w) {
+    char entry[80]; // longest entry: ,{"v":..,"min":..,"max":..,"t":..} with 11-char numbers
+    unsigned int len;
+
+    int actual_m = (req_m <= 0 || req_m >= tier->used) ? tier->used : req_m;
+    uint32_t oldest_slot = tier->newest_slot - (actual_m > 0 ? actual_m - 1 : 0);
+    unsigned long base_time = (unsigned long)oldest_slot * period;
+
+    writer_puts(w, "{\"bn\":\"");
+    writer_puts(w, BASE_NAME);
+    writer_puts(w, series->name);
+    writer_puts(w, "\",\"bu\":\"");
+    writer_puts(w, series->unit);
+    len = fmt_str(entry, "\",\"ver\":");
+    len += fmt_long(entry + len, VERSION);
+    len += fmt_str(entry + len, ",\"bt\":");
+    len += fmt_ulong(entry + len, base_time);
+    len += fmt_str(entry + len, ",\"res\":");
+    len += fmt_ulong(entry + len, period);
+    len += fmt_str(entry + len, ",\"e\":[");
+    writer_put(w, entry, len);
+
+    bool first = true;
+    for (int i = 0; i < actual_m; i++) {
+        const senml_bucket *bucket = &buckets[(tier->head - (actual_m - 1 - i) + slots) % slots];
+        if (bucket->count == 0) continue;
+
+        len = 0;
+        if (!first) entry[len++] = ',';
+        len += fmt_str(entry + len, "{\"v\":");
+        len += fmt_long(entry + len, bucket->sum / bucket->count);
+        len += fmt_str(entry + len, ",\"min\":");
+        len += fmt_long(entry + len, bucket->min);
+        len += fmt_str(entry + len, ",\"max\":");
+        len += fmt_long(entry + len, bucket->max);
+        len += fmt_str(entry + len, ",\"t\":");
+        len += fmt_ulong(entry + len, (unsigned long)i * period);
+        entry[len++] = '}';
+        writer_put(w, entry, len);
+        first = false;
+    }
+
+    writer_puts(w, "]}");
+}
+
+static void write_stats_json(const senml_series *series, senml_writer *w) {
+    const senml_stats *stats = &series->stats;
+    char entry[128]; // "ver", "n", "mean", "var", "min", "max" fields
+    unsigned int len;
+
+    writer_puts(w, "{\"bn\":\"");
+    writer_puts(w, BASE_NAME);
+    writer_puts(w, series->name);
+    writer_puts(w, "\",\"bu\":\"");
+    writer_puts(w, series->unit);
+    len = fmt_str(entry, "\",\"ver\":");
+    len += fmt_long(entry + len, VERSION);
+    len += fmt_str(entry + len, ",\"n\":");
+    len += fmt_ulong(entry + len, stats->count);
+    if (stats->count > 0) {
+        len += fmt_str(entry + len, ",\"mean\":");
+        len += fmt_fixed2(entry + len, stats->mean);
+        len += fmt_str(entry + len, ",\"var\":");
+        len += fmt_fixed2(entry + len, (stats->count > 1) ? stats->m2 / (float)(stats->count - 1) : 0.0f);
+        len += fmt_str(entry + len, ",\"min\":");
+        len += fmt_long(entry + len, stats->min);
+        len += fmt_str(entry + len, ",\"max\":");
+        len += fmt_long(entry + len, stats->max);
+    }
+    entry[len++] = '}';
+    writer_put(w, entry, len);
+}
+
+/* ---------------- SenML-CBOR encoding (content-format 112) ---------------- */
+
+// CBOR initial byte of major type 'major' with argument 'arg'
+static void cbor_put_head(senml_writer *w, uint8_t major, uint32_t arg) {
+    uint8_t head[5];
+    unsigned int len;
+
+    major <<= 5;
+    if (arg < 24) {
+        head[0] = major | (uint8_t)arg;
+        len = 1;
+    } else if (arg <= 0xFF) {
+        head[0] = major | 24;
+        head[1] = (uint8_t)arg;
+        len = 2;
+    } else if (arg <= 0xFFFF) {
+        head[0] = major | 25;
+        head[1] = (uint8_t)(arg >> 8);
+        head[2] = (uint8_t)arg;
+        len = 3;
+    } else {
+        head[0] = major | 26;
+        head[1] = (uint8_t)(arg >> 24);
+        head[2] = (uint8_t)(arg >> 16);
+        head[3] = (uint8_t)(arg >> 8);
+        head[4] = (uint8_t)arg;
+        len = 5;
+    }
+    writer_put(w, head, len);
+}
+
+// signed integer: major type 0 (unsigned) or 1 (negative, encoded as -1-n)
+static void cbor_put_int(senml_writer *w, long value) {
+    if (value >= 0) cbor_put_head(w, 0, (uint32_t)value);
+    else cbor_put_head(w, 1, (uint32_t)(-1 - value));
+}
+
+// text string: major type 3, 'prefix' and 'text' are concatenated in a single item
+static void cbor_put_text2(senml_writer *w, const char *prefix, const char *text) {
+    cbor_put_head(w, 3, strlen(prefix) + strlen(text));
+    writer_puts(w, prefix);
+    writer_puts(w, text);
+}
+
+/* Same content of the json payload, encoded as a RFC 8428 SenML-CBOR pack:
+*    [ {-2: bn, -3: bt, -4: bu, 2: v, 6: t}, {2: v, 6: t}, ... ]
+*  base fields are carried by the first (oldest) record only, values keep the json scaling (float * 100).
+*  bver is omitted: the record layout is the RFC 8428 one (version 10), not the "e" array of the json payload.
+*/
+static void write_senml_cbor(const senml_series *series, int req_m, senml_writer *w) {
+    if (series->count == 0) {
+        cbor_put_head(w, 4, 0); // No measurements available yet: empty pack
+        return;
+    }
+
+    record_cursor cursor;
+    int actual_m = window_open(series, req_m, &cursor);
+    unsigned long time, base_time = 0;
+    senml_value value;
+
+    cbor_put_head(w, 4, actual_m); // pack: array of records
+
+    for (int i = 0; i < actual_m; i++) {
+        history_next(&cursor, &time, &value);
+        if (i == 0) base_time = time;
+        int rel_time = (int)(time - base_time);
+
+        if (i == 0) {
+            cbor_put_head(w, 5, 5);
+            cbor_put_int(w, SENML_CBOR_BN);
+            cbor_put_text2(w, BASE_NAME, series->name);
+            cbor_put_int(w, SENML_CBOR_BT);
+            cbor_put_int(w, (long)base_time);
+            cbor_put_int(w, SENML_CBOR_BU);
+            cbor_put_text2(w, "", series->unit);
         } else {
-            // Unsupported value type
-            snprintf(payload + written, payload_size - written, "]}");
-            return;
+            cbor_put_head(w, 5, 2);
         }
+        cbor_put_int(w, SENML_CBOR_V);
+        cbor_put_int(w, record_value(series, value));
+        cbor_put_int(w, SENML_CBOR_T);
+        cbor_put_int(w, rel_time);
     }
+}
 
-    // Close the JSON object
-    snprintf(payload + written, payload_size - written, "]}");
+
+/* ---------------- Multi-series pack ---------------- */
+
+/* One RFC 8428 pack carrying the windows of several series (same layout for JSON and CBOR):
+*    [ {bn: <series 1>, bu, bt, v, t}, {v, t}, ..., {bn: <series 2>, bu, v, t}, {v, t}, ... ]
+*  bn/bu are set again at the first record of every series, bt only once: it is the oldest
+*  timestamp of all windows and every t is relative to it.
+*/
+
+// shared base time of the pack, 0 if no series has measurements
+static unsigned long pack_base_time(const senml_series *const series[], int n_series, int req_m) {
+    unsigned long base_time = 0;
+    bool found = false;
+
+    for (int s = 0; s < n_series; s++) {
+        if (series[s]->count == 0) continue;
+
+        record_cursor cursor;
+        unsigned long time;
+        senml_value value;
+        window_open(series[s], req_m, &cursor);
+        history_next(&cursor, &time, &value);
+        if (!found || time < base_time) base_time = time;
+        found = true;
+    }
+    return base_time;
+}
+
+static void write_pack_json(const senml_series *const series[], int n_series, int req_m, senml_writer *w) {
+    char entry[64]; // longest tail: ","bt":<20 digits>,"v":-2147483648,"t":-2147483648}
+    unsigned int len;
+    unsigned long base_time = pack_base_time(series, n_series, req_m);
+    bool first = true;
+
+    writer_puts(w, "[");
+    for (int s = 0; s < n_series; s++) {
+        if (series[s]->count == 0) continue;
+
+        record_cursor cursor;
+        int actual_m = window_open(series[s], req_m, &cursor);
+
+        for (int i = 0; i < actual_m; i++) {
+            unsigned long time;
+            senml_value value;
+            history_next(&cursor, &time, &value);
+
+            len = 0;
+            if (!first) entry[len++] = ',';
+            entry[len++] = '{';
+            if (i == 0) {
+                writer_put(w, entry, len);
+                writer_puts(w, "\"bn\":\"");
+                writer_puts(w, BASE_NAME);
+                writer_puts(w, series[s]->name);
+                writer_puts(w, "\",\"bu\":\"");
+                writer_puts(w, series[s]->unit);
+                len = fmt_str(entry, "\",");
+                if (first) {
+                    len += fmt_str(entry + len, "\"bt\":");
+                    len += fmt_ulong(entry + len, base_time);
+                    entry[len++] = ',';
+                }
+            }
+            len += fmt_str(entry + len, "\"v\":");
+            len += fmt_long(entry + len, record_value(series[s], value));
+            len += fmt_str(entry + len, ",\"t\":");
+            len += fmt_long(entry + len, (long)(time - base_time));
+            entry[len++] = '}';
+            writer_put(w, entry, len);
+            first = false;
+        }
+    }
+    writer_puts(w, "]");
 }
 
+static void write_pack_cbor(const senml_series *const series[], int n_series, int req_m, senml_writer *w) {
+    unsigned long base_time = pack_base_time(series, n_series, req_m);
+    record_cursor cursor;
+    uint32_t n_records = 0;
+    bool first = true;
+
+    for (int s = 0; s < n_series; s++) {
+        if (series[s]->count > 0) n_records += window_open(series[s], req_m, &cursor);
+    }
+    cbor_put_head(w, 4, n_records); // pack: array of records
+
+    for (int s = 0; s < n_series; s++) {
+        if (series[s]->count == 0) continue;
+
+        int actual_m = window_open(series[s], req_m, &cursor);
+
+        for (int i = 0; i < actual_m; i++) {
+            unsigned long time;
+            senml_value value;
+            history_next(&cursor, &time, &value);
+
+            if (i == 0) {
+                cbor_put_head(w, 5, first ? 5 : 4);
+                cbor_put_int(w, SENML_CBOR_BN);
+                cbor_put_text2(w, BASE_NAME, series[s]->name);
+                if (first) {
+                    cbor_put_int(w, SENML_CBOR_BT);
+                    cbor_put_int(w, (long)base_time);
+                }
+                cbor_put_int(w, SENML_CBOR_BU);
+                cbor_put_text2(w, "", series[s]->unit);
+            } else {
+                cbor_put_head(w, 5, 2);
+            }
+            cbor_put_int(w, SENML_CBOR_V);
+            cbor_put_int(w, record_value(series[s], value));
+            cbor_put_int(w, SENML_CBOR_T);
+            cbor_put_int(w, (long)(time - base_time));
+            first = false;
+        }
+    }
+}
+
+int senml_series_serialize(const senml_series *series, unsigned int content_format, int req_m,
+                           uint8_t *buffer, unsigned int buf_size, int32_t offset, int32_t *total_len) {
+    senml_writer w = { buffer, buf_size, offset, 0 };
+
+    if (content_format == SENML_CBOR_CONTENT_FORMAT) {
+        write_senml_cbor(series, req_m, &w);
+    } else {
+        write_senml_json(series, req_m, &w);
+    }
+
+    if (total_len) *total_len = w.pos;
+    return writer_written(&w);
+}
+
+int senml_series_serialize_rollup(const senml_series *series, unsigned int period, int req_m,
+                                  uint8_t *buffer, unsigned int buf_size, int32_t offset, int32_t *total_len) {
+    senml_writer w = { buffer, buf_size, offset, 0 };
+
+    if (period == SENML_ROLLUP_1M_PERIOD) {
+        write_rollup_json(series, &series->tier_1m, series->buckets_1m, SENML_ROLLUP_1M_SLOTS, period, req_m, &w);
+    } else if (period == SENML_ROLLUP_15M_PERIOD) {
+        write_rollup_json(series, &series->tier_15m, series->buckets_15m, SENML_ROLLUP_15M_SLOTS, period, req_m, &w);
+    } else {
+        return -1;
+    }
+
+    if (total_len) *total_len = w.pos;
+    return writer_written(&w);
+}
+
+int senml_pack_serialize(const senml_series *const series[], int n_series, unsigned int content_format, int req_m,
+                         uint8_t *buffer, unsigned int buf_size, int32_t offset, int32_t *total_len) {
+    senml_writer w = { buffer, buf_size, offset, 0 };
+
+    if (content_format == SENML_CBOR_CONTENT_FORMAT) {
+        write_pack_cbor(series, n_series, req_m, &w);
+    } else {
+        write_pack_json(series, n_series, req_m, &w);
+    }
+
+    if (total_len) *total_len = w.pos;
+    return writer_written(&w);
+}
+
+int senml_series_serialize_stats(const senml_series *series, uint8_t *buffer, unsigned int buf_size,
+                                 int32_t offset, int32_t *total_len) {
+    senml_writer w = { buffer, buf_size, offset, 0 };
+
+    write_stats_json(series, &w);
+
+    if (total_len) *total_len = w.pos;
+    return writer_written(&w);
+}
+
+void create_senml_json(const senml_series *series, char *payload, unsigned int payload_size, int req_m) {
+    if (payload_size == 0) return;
+    // keep room for the string terminator
+    int len = senml_series_serialize(series, SENML_JSON_CONTENT_FORMAT, req_m, (uint8_t *)payload, payload_size - 1, 0, NULL);
+    payload[len] = '\0';
+}
+
+int create_senml_cbor(const senml_series *series, uint8_t *payload, unsigned int payload_size, int req_m) {
+    int32_t total_len;
+    int len = senml_series_serialize(series, SENML_CBOR_CONTENT_FORMAT, req_m, payload, payload_size, 0, &total_len);
+    return (total_len > len) ? -1 : len;
+}
+
+/* Value of the requested_n-th last measurement (1 = newest):
+*  if requested_n is smaller than 1 or higher than the retained measurements, the oldest retained one is given
+*/
+static senml_value nth_last_value(const senml_series *series, int requested_n) {
+    int available_n = history_size(series);
+    int valid_requested_n = (requested_n <= 0 || requested_n > available_n) ? available_n : requested_n;
+
+    record_cursor cursor;
+    unsigned long time;
+    senml_value value;
+    history_seek(series, available_n - valid_requested_n, &cursor);
+    history_next(&cursor, &time, &value);
+    return value;
+}
 
 float get_nth_last_float(const senml_series *series, int requested_n) {
     if (!series || series->value_type != SENML_FLOAT || series->count == 0) {
         return -1.0f; // error or no element
     }
-    /* available_n: 
-    *        whatever the requested number, the buffer keeps the last HISTORY_SIZE measures at most
-    *  receivable_n:
-    *       if requested_n is smaller than 1 or higher than available, last inserted measurements is given 
-    */
-    int available_n = series->count < HISTORY_SIZE ? series->count : HISTORY_SIZE;
-    int valid_requested_n = (requested_n <= 0 || requested_n > available_n) ? available_n : requested_n;
-    
-    int newest_index = (series->index - 1 + HISTORY_SIZE) % HISTORY_SIZE;
-    int target_index = (newest_index - (valid_requested_n - 1) + HISTORY_SIZE) % HISTORY_SIZE;
-    return series->records[target_index].fvalue;
+    return nth_last_value(series, requested_n).fvalue;
 }
 
 // integer version for type-safe programming
@@ -125,20 +845,25 @@ int get_nth_last_int(const senml_series *series, int requested_n) {
     if (!series || series->value_type != SENML_INT || series->count == 0) {
         return -1; // error or no element
     }
-    /* available_n: 
-    *        whatever the requested number, the buffer keeps the last HISTORY_SIZE measures at most
-    *  receivable_n:
-    *       if requested_n is smaller than 1 or higher than available, last inserted measurements is given 
-    */
-    int available_n = series->count < HISTORY_SIZE ? series->count : HISTORY_SIZE;
-    int valid_requested_n = (requested_n <= 0 || requested_n > available_n) ? available_n : requested_n;
-
-    int newest_index = (series->index - 1 + HISTORY_SIZE) % HISTORY_SIZE;
-    int target_index = (newest_index - (valid_requested_n - 1) + HISTORY_SIZE) % HISTORY_SIZE;
-
-    return series->records[target_index].ivalue;
+    return nth_last_value(series, requested_n).ivalue;
 }
 
+long get_nth_last_payload(const senml_series *series, int requested_n) {
+    if (!series || series->count == 0) {
+        return 0;
+    }
+    return record_value(series, nth_last_value(series, requested_n));
+}
 
-
-
+float get_trend_slope(const senml_series *series) {
+    const senml_trend *trend = &series->trend;
+    int32_t n = trend->n;
+    if (n < 2) {
+        return 0.0f;
+    }
+    // slope = (n Sxy - Sx Sy) / (n Sxx - Sx^2), Sx = n(n-1)/2, Sxx = (n-1)n(2n-1)/6
+    int32_t sum_x = n * (n - 1) / 2;
+    int32_t sum_xx = (n - 1) * n * (2 * n - 1) / 6;
+    float num = (float)n * (float)trend->sum_xy - (float)sum_x * (float)trend->sum_y;
+    return num / (float)(n * sum_xx - sum_x * sum_x);
+}
@@ -3,51 +3,214 @@
 
 #include "network_config.h" //for GLOBAL CONSTANTS
 #include <stdbool.h> // for bool
+#include <stdint.h> // for uint8_t
 
-// size of circular buffer
+// measurements of the default payload window (one buffer cycle)
 #define HISTORY_SIZE PAYLOAD_MAX_MEASUREMENTS
 
+/* Raw history layout: the series sampled together share one timestamp ring (senml_timeline),
+*  each series keeps only an int16 fixed-point column of SENML_HISTORY_DEPTH values.
+*  Payloads default to the last HISTORY_SIZE measurements, ?n= can go up to the retained ones.
+*/
+#ifndef SENML_HISTORY_DEPTH
+#define SENML_HISTORY_DEPTH (2 * HISTORY_SIZE)
+#endif
+
+/* SENML_COMPRESSED_HISTORY (make SENML_STORE=compressed): keep the history in a compressed
+*  block ring (lib/senml_cstore.h) instead of the fixed-point columns.
+*/
+#ifndef SENML_COMPRESSED_HISTORY
+#define SENML_COMPRESSED_HISTORY 0
+#endif
+
+#if SENML_COMPRESSED_HISTORY
+#include "lib/senml_cstore.h"
+#endif
+
+/* Rollup tiers: min/max/avg of the measurements per 1-minute and per 15-minute bucket,
+*  updated on every add_measurement and served with ?res=1m|15m (values scaled as in the payloads)
+*/
+#define SENML_ROLLUP_1M_PERIOD  60   // sec
+#define SENML_ROLLUP_15M_PERIOD 900  // sec
+
+#ifndef SENML_ROLLUP_1M_SLOTS
+#define SENML_ROLLUP_1M_SLOTS 15  // last 15 minutes: an hour is served by the 15m tier
+#endif
+#ifndef SENML_ROLLUP_15M_SLOTS
+#define SENML_ROLLUP_15M_SLOTS 8  // last 2 hours
+#endif
+
+/* Least-squares trend of the last SENML_TREND_WINDOW measurements (payload scaling), updated on
+*  every add_measurement in O(1): running sums of y and x*y over a window ring, x = 0..n-1 oldest first
+*/
+#ifndef SENML_TREND_WINDOW
+#define SENML_TREND_WINDOW 8
+#endif
+
 // senML json constants
 #define BASE_NAME LOCAL_HOST  // fixed shared base prefix for all sensors
 #define VERSION 1
 #define NAME_MAX_LEN 16 //suffix name max length
 #define UNIT_MAX_LEN 8
 
+// CoAP content-format numbers selectable through the Accept option
+#define SENML_JSON_CONTENT_FORMAT 50   // APPLICATION_JSON, default encoding
+#define SENML_CBOR_CONTENT_FORMAT 112  // application/senml+cbor (RFC 8428)
+
+// senML cbor labels (RFC 8428, Table 4)
+#define SENML_CBOR_BN -2
+#define SENML_CBOR_BT -3
+#define SENML_CBOR_BU -4
+#define SENML_CBOR_V   2
+#define SENML_CBOR_T   6
+
+/* Output window over a serialized document:
+*  the document is produced from its first byte every time, but only the bytes falling in
+*  [offset, offset + size) are copied into buf. This lets a Block2 transfer resume at any
+*  offset without keeping the document (or a copy of it) in RAM.
+*/
+typedef struct {
+    uint8_t *buf;
+    unsigned int size;
+    int32_t offset; // document offset of buf[0]
+    int32_t pos;    // document bytes produced so far
+} senml_writer;
+
 typedef enum {
     SENML_FLOAT,
     SENML_INT
 } senml_value_type;
 
+/* Shared timestamps of the series sampled together: senml_timeline_advance opens a new row
+*  (timestamped now), then every series of the timeline adds its measurement of that row.
+*/
+typedef struct {
+#if !SENML_COMPRESSED_HISTORY
+    uint32_t time[SENML_HISTORY_DEPTH]; // seconds since epoch, one per row
+#endif
+    uint32_t now;  // time of the current row
+    int index;     // ring slot of the current row
+    int count;     // rows since init
+} senml_timeline;
+
+typedef struct {
+    int32_t min;
+    int32_t max;
+    int32_t sum;
+    uint16_t count; // 0: no measurement in the bucket period
+} senml_bucket;
+
 typedef struct {
-    union {
-        float fvalue;
-        int ivalue;
-    };
-    unsigned long time; // seconds since epoch
-} senml_record;
+    uint32_t newest_slot; // time / period of the newest bucket
+    uint16_t head;        // ring index of the newest bucket
+    uint16_t used;        // buckets in the ring
+} senml_tier;
+
+/* Running statistics since init (Welford), values scaled as in the payloads */
+typedef struct {
+    uint32_t count;
+    float mean;
+    float m2;     // sum of squared differences from the mean
+    int32_t min;
+    int32_t max;
+} senml_stats;
+
+typedef struct {
+    int32_t window[SENML_TREND_WINDOW]; // last values, payload scaling
+    int32_t sum_y;
+    int32_t sum_xy;
+    uint8_t oldest; // ring slot of the oldest value
+    uint8_t n;      // values in the window
+} senml_trend;
 
 typedef struct {
     char name[NAME_MAX_LEN];
     char unit[UNIT_MAX_LEN];
     senml_value_type value_type;
-    
-    senml_record records[HISTORY_SIZE];
-    int count;
-    int index; // circular buffer index
+    const senml_timeline *timeline;
+
+#if SENML_COMPRESSED_HISTORY
+    senml_cstore store;
+#else
+    // column value = (measurement - offset) * scale, rounded and saturated to int16
+    // (int series: scale 1, only the offset applies)
+    int16_t column[SENML_HISTORY_DEPTH];
+    float scale;
+    int32_t offset;
+#endif
+    int count; // measurements added since init
+
+    senml_tier tier_1m;
+    senml_bucket buckets_1m[SENML_ROLLUP_1M_SLOTS];
+    senml_tier tier_15m;
+    senml_bucket buckets_15m[SENML_ROLLUP_15M_SLOTS];
+
+    senml_stats stats;
+    senml_trend trend;
 } senml_series;
 
 
-void init_measurements_series(senml_series *series, const char *name, const char *unit, senml_value_type type);
+void senml_timeline_init(senml_timeline *timeline);
+void senml_timeline_advance(senml_timeline *timeline);
+
+/* Default column scaling: float series * 100 (payload resolution), int series as they are */
+void init_measurements_series(senml_series *series, const senml_timeline *timeline,
+                              const char *name, const char *unit, senml_value_type type);
+
+/* Fixed-point column of the series: (measurement - offset) * scale must fit in int16
+*  (ignored with SENML_COMPRESSED_HISTORY, the compressed store is lossless)
+*/
+void senml_series_set_scaling(senml_series *series, float scale, int32_t offset);
 
 void add_measurement(senml_series *series, float value);
 void add_measurement_int(senml_series *series, int value);
 
 bool is_buffer_cycle_complete(senml_series *series);
 
+/* Serialize the last req_m measurements (SenML JSON or CBOR, by content_format) writing only the
+*  bytes [offset, offset + buf_size) of the document into buffer: used for Block2 transfers.
+*  Returns the bytes written into buffer, total_len (if not NULL) is set to the document length.
+*/
+int senml_series_serialize(const senml_series *series, unsigned int content_format, int req_m,
+                           uint8_t *buffer, unsigned int buf_size, int32_t offset, int32_t *total_len);
+
+/* Same as senml_series_serialize for the rollup tier of 'period' seconds (SENML_ROLLUP_1M_PERIOD or
+*  SENML_ROLLUP_15M_PERIOD), last req_m buckets: SenML JSON entries {"v":avg,"min":..,"max":..,"t":..}.
+*  Returns -1 if there is no tier of that period.
+*/
+int senml_series_serialize_rollup(const senml_series *series, unsigned int period, int req_m,
+                                  uint8_t *buffer, unsigned int buf_size, int32_t offset, int32_t *total_len);
+
+/* Same as senml_series_serialize for the last req_m measurements of n_series series in a single
+*  RFC 8428 pack (JSON or CBOR records): bn/bu at the first record of every series, one shared bt.
+*/
+int senml_pack_serialize(const senml_series *const series[], int n_series, unsigned int content_format, int req_m,
+                         uint8_t *buffer, unsigned int buf_size, int32_t offset, int32_t *total_len);
+
+/* Same as senml_series_serialize for the running statistics of the series (SenML JSON):
+*    {"bn":..,"bu":..,"ver":1,"n":<count>,"mean":..,"var":..,"min":..,"max":..}
+*  mean and var (sample variance) with two decimals, all in the payload value scaling.
+*/
+int senml_series_serialize_stats(const senml_series *series, uint8_t *buffer, unsigned int buf_size,
+                                 int32_t offset, int32_t *total_len);
+
+/* Windowed writer for the other documents served in Block2 chunks (e.g. /metrics):
+*  w->pos is the document length once it has been written to the end
+*/
+void senml_writer_init(senml_writer *w, uint8_t *buf, unsigned int size, int32_t offset);
+void senml_writer_put(senml_writer *w, const void *data, unsigned int len);
+void senml_writer_puts(senml_writer *w, const char *text);
+int senml_writer_written(const senml_writer *w); // bytes copied into buf
+
 void create_senml_json(const senml_series *series, char *buffer, unsigned int buf_size, int req_m);
+int create_senml_cbor(const senml_series *series, uint8_t *buffer, unsigned int buf_size, int req_m);
 
 float get_nth_last_float(const senml_series *series, int requested_n);
 int get_nth_last_int(const senml_series *series, int requested_n);
+// nth last value as transmitted (floats * 100, rounded), 0 if the series is empty
+long get_nth_last_payload(const senml_series *series, int requested_n);
+// least-squares slope of the trend window, payload units per measurement (0 with less than 2 values)
+float get_trend_slope(const senml_series *series);
 
 #endif // SENML_SERIES_H
 
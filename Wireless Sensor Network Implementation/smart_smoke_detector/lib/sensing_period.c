@@ -0,0 +1,40 @@
+#include "lib/sensing_period.h"
+
+static uint16_t clamp_period(const sensing_period_t *sp, uint32_t period) {
+  if(period < sp->min) return sp->min;
+  if(period > sp->max) return sp->max;
+  return (uint16_t)period;
+}
+
+void sensing_period_init(sensing_period_t *sp, uint16_t initial_period) {
+  sp->min = SENSING_PERIOD_MIN_DEFAULT;
+  sp->max = SENSING_PERIOD_MAX_DEFAULT;
+  sp->period = clamp_period(sp, initial_period);
+  sp->quiet = 0;
+  sp->samples = 0;
+  sp->shortened = 0;
+  sp->detection_latency = 0;
+}
+
+uint16_t sensing_period_update(sensing_period_t *sp, bool volatile_env) {
+  sp->samples++;
+  if(volatile_env) {
+    if(sp->period != sp->min) sp->shortened++;
+    sp->period = sp->min;
+    sp->quiet = 0;
+  } else if(++sp->quiet >= SENSING_QUIET_SAMPLES) {
+    sp->period = clamp_period(sp, (uint32_t)sp->period * 2);
+    sp->quiet = 0;
+  }
+  return sp->period;
+}
+
+bool sensing_period_set_bounds(sensing_period_t *sp, int min, int max) {
+  if(min < 1 || min > max || max > SENSING_PERIOD_LIMIT) {
+    return false;
+  }
+  sp->min = (uint16_t)min;
+  sp->max = (uint16_t)max;
+  sp->period = clamp_period(sp, sp->period);
+  return true;
+}
@@ -0,0 +1,43 @@
+#ifndef SENSING_PERIOD_H
+#define SENSING_PERIOD_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Adaptive sensing period: the detector samples at the lower bound as soon as the environment
+*  is volatile (sustained trends, rising particulate matter, alarm status) and stretches the period,
+*  doubling it every SENSING_QUIET_SAMPLES quiet samples, up to the upper bound in steady state.
+*  Bounds are set through the /sensing resource (resources/res-sensing.c).
+*/
+
+#ifndef SENSING_PERIOD_MIN_DEFAULT
+#define SENSING_PERIOD_MIN_DEFAULT 1 // sec
+#endif
+#ifndef SENSING_PERIOD_MAX_DEFAULT
+#define SENSING_PERIOD_MAX_DEFAULT 15 // sec
+#endif
+#define SENSING_PERIOD_LIMIT 300 // highest settable bound, sec
+
+#ifndef SENSING_QUIET_SAMPLES
+#define SENSING_QUIET_SAMPLES 5 // quiet samples before the period is stretched
+#endif
+
+typedef struct {
+    uint16_t min;       // bounds, sec
+    uint16_t max;
+    uint16_t period;    // current period, sec
+    uint16_t quiet;     // consecutive quiet samples
+    uint32_t samples;   // samples taken since boot
+    uint32_t shortened; // samples that brought the period back to min
+    uint32_t detection_latency; // sec from the last simulated ignition to fire status, 0: none
+} sensing_period_t;
+
+void sensing_period_init(sensing_period_t *sp, uint16_t initial_period);
+
+// accounts for a new sample; returns the period to wait before the next one
+uint16_t sensing_period_update(sensing_period_t *sp, bool volatile_env);
+
+// returns false (bounds unchanged) unless 1 <= min <= max <= SENSING_PERIOD_LIMIT
+bool sensing_period_set_bounds(sensing_period_t *sp, int min, int max);
+
+#endif // SENSING_PERIOD_H
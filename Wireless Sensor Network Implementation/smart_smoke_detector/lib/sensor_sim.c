@@ -13,16 +13,6 @@ static int clamp_int(int val, int min, int max) {
     return val;
 }
 
-static float random_delta(float max_delta) {
-    float delta = ((float)rand() / RAND_MAX) * max_delta;
-    return (rand() % 2 == 0) ? delta : -delta;
-}
-
-static int random_delta_int(int max_delta) {
-    int delta = rand() % (max_delta + 1); //rand() returns pseudorandom values much larger than 100 000
-    return (rand() % 2 == 0) ? delta : -delta;
-}
-
 static float step_towards(float current, float target, float step) {
     if (fabsf(current - target) <= step) return target;
     return current + (current < target ? step : -step);
@@ -33,9 +23,13 @@ static int step_towards_int(int current, int target, int step) {
     return current + (current < target ? step : -step);
 }
 
+void sensor_sim_seed(sensor_sim_t *s, uint32_t seed) {
+    s->rng = seed ? seed : SENSOR_SIM_DEFAULT_SEED; // xorshift32 stays at 0 forever
+}
+
 void simulate_first_measurements(sensor_sim_t *s) {
     if (!s) return;
-    srand(12345);
+    sensor_sim_seed(s, SENSOR_SIM_DEFAULT_SEED);
 
     s->temperature   = TEMP_STD;
     s->humidity      = HUMIDITY_STD;
@@ -78,12 +72,12 @@ void simulate_new_measurements(sensor_sim_t *s, bool is_fire, bool is_hazard) {
 
         s->fire_recovery_count--;
     } else {
-	s->temperature = clamp(s->temperature + random_delta(TEMP_DELTA),        TEMP_MIN,     TEMP_MAX);
-	s->humidity    = clamp(s->humidity    + random_delta(HUMIDITY_DELTA),    HUMIDITY_MIN, HUMIDITY_MAX);
-	s->pressure    = clamp(s->pressure    + random_delta(PRESSURE_DELTA),    PRESSURE_MIN, PRESSURE_MAX);
-	s->tvoc        = clamp_int(s->tvoc        + random_delta_int(TVOC_DELTA),    TVOC_MIN,     TVOC_MAX);
-	s->raw_h2      = clamp_int(s->raw_h2      + random_delta_int(RAW_H2_DELTA),  RAW_H2_MIN,   RAW_H2_MAX);
-	s->raw_ethanol = clamp_int(s->raw_ethanol + random_delta_int(RAW_ETH_DELTA), RAW_ETH_MIN,  RAW_ETH_MAX);
+	s->temperature = clamp(s->temperature + sensor_sim_delta(&s->rng, TEMP_DELTA),        TEMP_MIN,     TEMP_MAX);
+	s->humidity    = clamp(s->humidity    + sensor_sim_delta(&s->rng, HUMIDITY_DELTA),    HUMIDITY_MIN, HUMIDITY_MAX);
+	s->pressure    = clamp(s->pressure    + sensor_sim_delta(&s->rng, PRESSURE_DELTA),    PRESSURE_MIN, PRESSURE_MAX);
+	s->tvoc        = clamp_int(s->tvoc        + sensor_sim_delta_int(&s->rng, TVOC_DELTA),    TVOC_MIN,     TVOC_MAX);
+	s->raw_h2      = clamp_int(s->raw_h2      + sensor_sim_delta_int(&s->rng, RAW_H2_DELTA),  RAW_H2_MIN,   RAW_H2_MAX);
+	s->raw_ethanol = clamp_int(s->raw_ethanol + sensor_sim_delta_int(&s->rng, RAW_ETH_DELTA), RAW_ETH_MIN,  RAW_ETH_MAX);
     }
     
     
@@ -102,9 +96,9 @@ void simulate_new_measurements(sensor_sim_t *s, bool is_fire, bool is_hazard) {
 	
 	s-> hazard_recovery_count--;
     } else {
-    	s->pm1_0       = clamp_int(s->pm1_0       + random_delta_int(PM1_0_DELTA),   PM1_0_MIN,    PM1_0_MAX);
-        s->pm2_5       = clamp_int(s->pm2_5       + random_delta_int(PM2_5_DELTA),   PM2_5_MIN,    PM2_5_MAX);
-        s->nc0_5       = clamp_int(s->nc0_5       + random_delta_int(NC0_5_DELTA),   NC0_5_MIN,    NC0_5_MAX);
+    	s->pm1_0       = clamp_int(s->pm1_0       + sensor_sim_delta_int(&s->rng, PM1_0_DELTA),   PM1_0_MIN,    PM1_0_MAX);
+        s->pm2_5       = clamp_int(s->pm2_5       + sensor_sim_delta_int(&s->rng, PM2_5_DELTA),   PM2_5_MIN,    PM2_5_MAX);
+        s->nc0_5       = clamp_int(s->nc0_5       + sensor_sim_delta_int(&s->rng, NC0_5_DELTA),   NC0_5_MIN,    NC0_5_MAX);
     }
 }
 
@@ -2,6 +2,7 @@
 #define SENSOR_SIM_H
 
 #include <stdbool.h>
+#include <stdint.h>
 
 // Sensor Data Structure
 typedef struct {
@@ -16,6 +17,7 @@ typedef struct {
     int nc0_5;
     int fire_recovery_count;
     int hazard_recovery_count;
+    uint32_t rng; // xorshift32 state of this simulator (never 0)
 } sensor_sim_t;
 
 
@@ -91,8 +93,37 @@ typedef struct {
 #define MAX_FIRE_RECOVERY_PERIOD    5 //measurements
 #define MAX_HAZARD_RECOVERY_PERIOD  5 //measurements
 
+#define SENSOR_SIM_DEFAULT_SEED 12345u
+
+/* Per-instance pseudo-random source: xorshift32 (Marsaglia), state kept in the simulator, so every
+*  simulator is reproducible from its seed whatever the others do. Shared with the host batch
+*  simulator (host/sensor_fleet.c), which steps the same model in SoA layout.
+*/
+static inline uint32_t sensor_sim_random(uint32_t *state) {
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return *state = x;
+}
+
+// uniform in (-max_delta, max_delta): magnitude from the high 24 bits, sign from the lowest one
+static inline float sensor_sim_delta(uint32_t *state, float max_delta) {
+    uint32_t r = sensor_sim_random(state);
+    float delta = (float)(r >> 8) * (1.0f / 16777216.0f) * max_delta;
+    return (r & 1) ? -delta : delta;
+}
+
+static inline int sensor_sim_delta_int(uint32_t *state, int max_delta) {
+    uint32_t r = sensor_sim_random(state);
+    int delta = (int)((r >> 8) % (uint32_t)(max_delta + 1));
+    return (r & 1) ? -delta : delta;
+}
+
 // Functions
 void simulate_first_measurements(sensor_sim_t *s);
+// seed of the simulator pseudo-random source (0 is replaced by SENSOR_SIM_DEFAULT_SEED)
+void sensor_sim_seed(sensor_sim_t *s, uint32_t seed);
 void simulate_new_measurements(sensor_sim_t *s, bool is_fire, bool is_hazard);
 
 #endif // SENSOR_SIM_H
@@ -0,0 +1,49 @@
+#include "lib/sensor_table.h"
+#include <stddef.h> // for offsetof
+#include <string.h>
+
+senml_timeline sensor_timeline;
+
+#define SENSOR_SERIES(id, ...) senml_series id##_series;
+SENSOR_TABLE(SENSOR_SERIES)
+#undef SENSOR_SERIES
+
+#define SENSOR_ROW(id, field, title, rt, unit, type, scale, offset, change, deadband, mean, sd, feature, limit, max) \
+  { #id, unit, type, scale, offset, offsetof(sensor_sim_t, field), &id##_series, &res_##id, change, deadband, limit, max },
+const sensor_desc_t sensor_table[SENSOR_COUNT] = {
+  SENSOR_TABLE(SENSOR_ROW)
+};
+#undef SENSOR_ROW
+
+#define SENSOR_SERIES_PTR(id, ...) &id##_series,
+const senml_series *const sensor_series[SENSOR_COUNT] = {
+  SENSOR_TABLE(SENSOR_SERIES_PTR)
+};
+#undef SENSOR_SERIES_PTR
+
+#define SENSOR_LIMIT(id, field, title, rt, unit, type, scale, offset, change, deadband, mean, sd, feature, limit, max) limit,
+int sensor_limit[SENSOR_COUNT] = {
+  SENSOR_TABLE(SENSOR_LIMIT)
+};
+#undef SENSOR_LIMIT
+
+notify_policy_t sensor_notify[SENSOR_COUNT]; // set up by initialize_sensor_resources()
+
+
+float sensor_value(const sensor_sim_t *sensors, const sensor_desc_t *desc) {
+  const char *field = (const char *)sensors + desc->field;
+  if(desc->type == SENML_FLOAT) {
+    return *(const float *)field;
+  }
+  return (float)*(const int *)field;
+}
+
+const sensor_desc_t *sensor_by_name(const char *name, int len) {
+  for(int i = 0; i < SENSOR_COUNT; i++) {
+    const char *row_name = sensor_table[i].name;
+    if(strncmp(row_name, name, len) == 0 && row_name[len] == '\0') {
+      return &sensor_table[i];
+    }
+  }
+  return NULL;
+}
@@ -0,0 +1,91 @@
+#ifndef SENSOR_TABLE_H
+#define SENSOR_TABLE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "coap-engine.h"
+#include "lib/senml_series.h"
+#include "lib/notify_policy.h"
+#include "lib/sensor_sim.h"
+#include "lib/features_norm_constants.h"
+
+// WARNING: 500 µg/m³ is a 1-sec hazardous spike (WHO annual safe limit: 10 µg/m³)
+#define PM1_0_STD_SAFE_LIMIT 250
+// WARNING: 1000 µg/m³ is a 1-sec emergency-level spike (WHO annual safe limit: 5 µg/m³)
+#define PM2_5_STD_SAFE_LIMIT 250
+// WARNING: 5000 particles/cm³ is a 1-sec severe pollution spike (Typical indoor safe level: <2000 particles/cm³)
+#define NC0_5_STD_SAFE_LIMIT 2500
+
+// resource titles: queries accepted by every sensor resource, plus the safety limit ones
+#define SENSOR_QUERIES ": ?n=0.., res=1m|15m, stats, POST/PUT deadband=<d>, max_interval=<sec>"
+#define SENSOR_LIMIT_QUERIES SENSOR_QUERIES ", limit=<limit>"
+
+/* ---------------- Sensor table ----------------
+*  One row per sensor, in pack/registration order. Adding a sensor means adding a row here
+*  (and its field in sensor_sim_t). Columns:
+*    id        resource path and series name (res_<id>, <id>_series)
+*    field     sensor_sim_t field
+*    title     resource title
+*    rt        suffix of the resource type urn:ietf:senml:json:<rt>
+*    unit      senML unit
+*    type      SENML_FLOAT (float field) or SENML_INT (int field)
+*    scale, offset  int16 history column: (value - offset) * scale (int fields: scale 1), must cover the
+*              sensor range: the particulate matter columns use offset 32768 for 0..65535 (the Kaggle
+*              dataset reaches ~45k PM2.5 and ~61k NC0.5), checked by host/check-senml-columns
+*    change    trend threshold: fitted rise over the trend window (0: not checked)
+*    deadband  default notification deadband, payload units: floats * 100 (lib/notify_policy.h)
+*    mean, sd  normalization of the model input (lib/fire_model.c)
+*    feature   model input index (-1: not a model input)
+*    limit     default safety limit, POST/PUT limit=<limit> (0: no limit)
+*    max       highest settable limit
+*/
+#define SENSOR_TABLE(X) \
+  /* id          field        title                         rt             unit     type         scale   offset  change                       deadband  mean              sd                   feature  limit                 max      */ \
+  X(temp,        temperature, "Temperature" SENSOR_QUERIES, "temperature", "C",     SENML_FLOAT, 100.0f, 0,      (TEMP_FIRE_STEP * 2.0f),     50,       MEAN_TEMP,        STD_DEV_TEMP,        0,       0,                    0        ) \
+  X(hum,         humidity,    "Humidity" SENSOR_QUERIES,    "humidity",    "%",     SENML_FLOAT, 100.0f, 0,      (HUMIDITY_FIRE_STEP * 2.0f), 100,      MEAN_HUMIDITY,    STD_DEV_HUMIDITY,    1,       0,                    0        ) \
+  X(pressure,    pressure,    "Pressure" SENSOR_QUERIES,    "pressure",    "hPa",   SENML_FLOAT, 100.0f, 900,    (PRESSURE_FIRE_STEP * 2.0f), 50,       MEAN_PRESSURE,    STD_DEV_PRESSURE,    5,       0,                    0        ) \
+  X(tvoc,        tvoc,        "TVOC" SENSOR_QUERIES,        "tvoc",        "ppb",   SENML_INT,   1.0f,   30000,  (TVOC_FIRE_STEP * 2),        1000,     MEAN_TVOC,        STD_DEV_TVOC,        2,       0,                    0        ) \
+  X(raw_h2,      raw_h2,      "Raw H2" SENSOR_QUERIES,      "raw_h2",      "ppm",   SENML_INT,   1.0f,   0,      (RAW_H2_FIRE_STEP * 2),      100,      MEAN_RAW_H2,      STD_DEV_RAW_H2,      3,       0,                    0        ) \
+  X(raw_ethanol, raw_ethanol, "Raw Ethanol" SENSOR_QUERIES, "raw_ethanol", "ppm",   SENML_INT,   1.0f,   0,      (RAW_ETH_FIRE_STEP * 2),     200,      MEAN_RAW_ETHANOL, STD_DEV_RAW_ETHANOL, 4,       0,                    0        ) \
+  X(pm1_0,       pm1_0,       "PM1.0" SENSOR_LIMIT_QUERIES, "pm1_0",       "µg/m3", SENML_INT,   1.0f,   32768,  0,                           10,       MEAN_PM1_0,       STD_DEV_PM1_0,       6,       PM1_0_STD_SAFE_LIMIT, PM1_0_MAX) \
+  X(pm2_5,       pm2_5,       "PM2.5" SENSOR_LIMIT_QUERIES, "pm2_5",       "µg/m3", SENML_INT,   1.0f,   32768,  0,                           10,       MEAN_PM2_5,       STD_DEV_PM2_5,       7,       PM2_5_STD_SAFE_LIMIT, PM2_5_MAX) \
+  X(nc0_5,       nc0_5,       "NC0.5" SENSOR_LIMIT_QUERIES, "nc0_5",       "p/cm3", SENML_INT,   1.0f,   32768,  0,                           200,      MEAN_NC0_5,       STD_DEV_NC0_5,       8,       NC0_5_STD_SAFE_LIMIT, NC0_5_MAX)
+
+// sensor indexes: SENSOR_temp, SENSOR_hum, ...
+#define SENSOR_ENUM(id, ...) SENSOR_##id,
+enum { SENSOR_TABLE(SENSOR_ENUM) SENSOR_COUNT };
+#undef SENSOR_ENUM
+
+typedef struct {
+    const char *name;           // resource path and series name
+    const char *unit;
+    senml_value_type type;
+    float column_scale;
+    int32_t column_offset;
+    uint16_t field;             // offset of the value in sensor_sim_t
+    senml_series *series;
+    coap_resource_t *resource;
+    float change_step;          // 0: no trend detection
+    int32_t notify_deadband;    // default deadband, payload units
+    int limit_default;          // 0: no safety limit
+    int limit_max;
+} sensor_desc_t;
+
+// Resource Data Structures: Time series buffers organized as a senML object
+#define SENSOR_EXTERN(id, ...) extern senml_series id##_series; extern coap_resource_t res_##id;
+SENSOR_TABLE(SENSOR_EXTERN)
+#undef SENSOR_EXTERN
+
+extern senml_timeline sensor_timeline; // shared timestamps: all sensors are sampled together
+extern const sensor_desc_t sensor_table[SENSOR_COUNT];
+extern const senml_series *const sensor_series[SENSOR_COUNT]; // pack order
+extern int sensor_limit[SENSOR_COUNT]; // current safety limits (rows with limit_default > 0)
+extern notify_policy_t sensor_notify[SENSOR_COUNT]; // current notification policies
+
+// sensed value of the row field, as float
+float sensor_value(const sensor_sim_t *sensors, const sensor_desc_t *desc);
+
+// row of the resource path (not NUL terminated), NULL if unknown
+const sensor_desc_t *sensor_by_name(const char *name, int len);
+
+#endif // SENSOR_TABLE_H
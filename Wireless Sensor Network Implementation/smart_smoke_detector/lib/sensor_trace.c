@@ -0,0 +1,91 @@
+#include "lib/sensor_trace.h"
+#include <stddef.h> // for offsetof
+#include <stdlib.h>
+#include <string.h>
+
+static const struct {
+    const char *column;
+    uint16_t field;  // offset in sensor_sim_t
+    bool is_float;
+} trace_fields[SENSOR_TRACE_FIELDS] = {
+    { "Temperature[C]", offsetof(sensor_sim_t, temperature), true  },
+    { "Humidity[%]",    offsetof(sensor_sim_t, humidity),    true  },
+    { "TVOC[ppb]",      offsetof(sensor_sim_t, tvoc),        false },
+    { "Raw H2",         offsetof(sensor_sim_t, raw_h2),      false },
+    { "Raw Ethanol",    offsetof(sensor_sim_t, raw_ethanol), false },
+    { "Pressure[hPa]",  offsetof(sensor_sim_t, pressure),    true  },
+    { "PM1.0",          offsetof(sensor_sim_t, pm1_0),       false },
+    { "PM2.5",          offsetof(sensor_sim_t, pm2_5),       false },
+    { "NC0.5",          offsetof(sensor_sim_t, nc0_5),       false },
+};
+
+#define LABEL_COLUMN "Fire Alarm"
+#define UTC_COLUMN "UTC"
+
+// splits a CSV line in place (no quoted commas in the dataset), strips quotes and line end
+static int split_line(char *line, char **cells, int max) {
+  int n = 0;
+  char *cell = line;
+  while(n < max) {
+    char *end = cell + strcspn(cell, ",\r\n");
+    char sep = *end;
+    *end = '\0';
+    if(*cell == '"') cell++;
+    size_t len = strlen(cell);
+    if(len && cell[len - 1] == '"') cell[len - 1] = '\0';
+    cells[n++] = cell;
+    if(sep != ',') break;
+    cell = end + 1;
+  }
+  return n;
+}
+
+int sensor_trace_parse_header(sensor_trace_header *header, char *line, const char **missing) {
+  char *cells[SENSOR_TRACE_MAX_COLUMNS];
+  int n = split_line(line, cells, SENSOR_TRACE_MAX_COLUMNS);
+
+  header->label_column = -1;
+  header->utc_column = -1;
+  for(int f = 0; f < SENSOR_TRACE_FIELDS; f++) {
+    header->field_column[f] = -1;
+  }
+  for(int c = 0; c < n; c++) {
+    for(int f = 0; f < SENSOR_TRACE_FIELDS; f++) {
+      if(strcmp(cells[c], trace_fields[f].column) == 0) header->field_column[f] = (int8_t)c;
+    }
+    if(strcmp(cells[c], LABEL_COLUMN) == 0) header->label_column = (int8_t)c;
+    if(strcmp(cells[c], UTC_COLUMN) == 0) header->utc_column = (int8_t)c;
+  }
+  for(int f = 0; f < SENSOR_TRACE_FIELDS; f++) {
+    if(header->field_column[f] < 0) {
+      if(missing) *missing = trace_fields[f].column;
+      return -1;
+    }
+  }
+  return 0;
+}
+
+int sensor_trace_parse_row(const sensor_trace_header *header, char *line, sensor_sim_t *sensors, int *label,
+                           uint32_t *utc) {
+  char *cells[SENSOR_TRACE_MAX_COLUMNS];
+  int n = split_line(line, cells, SENSOR_TRACE_MAX_COLUMNS);
+
+  for(int f = 0; f < SENSOR_TRACE_FIELDS; f++) {
+    if(header->field_column[f] >= n) return -1;
+  }
+  for(int f = 0; f < SENSOR_TRACE_FIELDS; f++) {
+    const char *cell = cells[header->field_column[f]];
+    char *field = (char *)sensors + trace_fields[f].field;
+    float value = strtof(cell, NULL);
+    if(trace_fields[f].is_float) {
+      *(float *)field = value;
+    } else {
+      *(int *)field = (int)(value + (value < 0 ? -0.5f : 0.5f));
+    }
+  }
+  *label = (header->label_column >= 0 && header->label_column < n) ? atoi(cells[header->label_column]) : -1;
+  if(utc) {
+    *utc = (header->utc_column >= 0 && header->utc_column < n) ? (uint32_t)strtoul(cells[header->utc_column], NULL, 10) : 0;
+  }
+  return 0;
+}
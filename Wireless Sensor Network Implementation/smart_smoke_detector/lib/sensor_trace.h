@@ -0,0 +1,35 @@
+#ifndef SENSOR_TRACE_H
+#define SENSOR_TRACE_H
+
+#include <stdint.h>
+#include "lib/sensor_sim.h"
+
+/* Sensor traces in the CSV layout of the Kaggle "Smoke Detection Dataset" the fire detector
+*  was trained on (smoke_detection_iot.csv): one header line naming the columns, then one line
+*  per measurement. Columns are found by name, unknown ones are ignored:
+*    Temperature[C], Humidity[%], TVOC[ppb], Raw H2, Raw Ethanol, Pressure[hPa],
+*    PM1.0, PM2.5, NC0.5 (sensor_sim_t fields), Fire Alarm (ground truth, optional),
+*    UTC (measurement time, optional)
+*  Values of int fields are rounded (the dataset has fractional particulate matter readings).
+*  The parser works on lines already read, without stdio, and modifies them.
+*/
+
+#define SENSOR_TRACE_FIELDS 9
+#define SENSOR_TRACE_MAX_COLUMNS 32
+
+typedef struct {
+    int8_t field_column[SENSOR_TRACE_FIELDS]; // column of every sensor_sim_t field
+    int8_t label_column;                      // -1: no Fire Alarm column
+    int8_t utc_column;                        // -1: no UTC column
+} sensor_trace_header;
+
+// returns 0, or -1 if a sensor column is missing (*missing: its name)
+int sensor_trace_parse_header(sensor_trace_header *header, char *line, const char **missing);
+
+// fields of a measurement line into sensors (others left untouched),
+// *label: Fire Alarm value, -1 if unknown, *utc (if not NULL): UTC value, 0 if unknown.
+// Returns -1 on a short line
+int sensor_trace_parse_row(const sensor_trace_header *header, char *line, sensor_sim_t *sensors, int *label,
+                           uint32_t *utc);
+
+#endif // SENSOR_TRACE_H
@@ -0,0 +1,162 @@
+#include "lib/stage_timing.h"
+
+#if ENERGEST_CONF_ON
+#define STAGE_ENERGEST(name, energest) ENERGEST_TYPE_##energest,
+const energest_type_t stage_energest[STAGE_COUNT] = { STAGE_TABLE(STAGE_ENERGEST) };
+#undef STAGE_ENERGEST
+
+#define STAGE_ENERGEST_NONE ENERGEST_TYPE_MAX
+
+// type of the innermost running stage, and the one each stage paused when it began
+static energest_type_t energest_running = STAGE_ENERGEST_NONE;
+static energest_type_t energest_paused[STAGE_COUNT];
+
+void stage_energest_on(stage_t stage) {
+  energest_type_t type = stage_energest[stage];
+  energest_paused[stage] = energest_running;
+  if(energest_running != type) {
+    if(energest_running != STAGE_ENERGEST_NONE) {
+      ENERGEST_OFF(energest_running);
+    }
+    ENERGEST_ON(type);
+    energest_running = type;
+  }
+}
+
+void stage_energest_off(stage_t stage) {
+  energest_type_t outer = energest_paused[stage];
+  if(outer != energest_running) {
+    ENERGEST_OFF(energest_running);
+    if(outer != STAGE_ENERGEST_NONE) {
+      ENERGEST_ON(outer);
+    }
+    energest_running = outer;
+  }
+}
+#endif
+
+#if STAGE_TIMING
+
+#include "contiki.h"
+#include "sys/log.h"
+#include <stdbool.h>
+
+#define LOG_MODULE "Stages"
+#define LOG_LEVEL LOG_LEVEL_APP
+
+#include <stdio.h> // for snprintf
+#include <string.h> // for memcpy
+
+#ifdef CONTIKI_TARGET_NATIVE
+#include <time.h>
+#define STAGE_TIME_UNIT "ns"
+#define STAGE_TIME_SECOND 1000000000ULL
+#elif defined(NRF52840_XXAA)
+#include "nrf.h"
+#define STAGE_TIME_UNIT "cycles"
+#define STAGE_TIME_SECOND ((uint64_t)SystemCoreClock)
+#define STAGE_TIME_DWT 1
+#else
+#include "sys/rtimer.h"
+#define STAGE_TIME_UNIT "rtimer ticks"
+#define STAGE_TIME_SECOND ((uint64_t)RTIMER_SECOND)
+#endif
+
+#define STAGE_NAME(name, energest) #name,
+static const char *const stage_names[STAGE_COUNT] = { STAGE_TABLE(STAGE_NAME) };
+#undef STAGE_NAME
+
+static stage_stats_t stages[STAGE_COUNT];
+static uint32_t iterations;
+static stage_time_t first_iteration;
+
+stage_time_t stage_timing_now(void) {
+#ifdef CONTIKI_TARGET_NATIVE
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (stage_time_t)ts.tv_sec * STAGE_TIME_SECOND + ts.tv_nsec;
+#elif STAGE_TIME_DWT
+  static bool started;
+  static uint32_t last;
+  static stage_time_t wraps;
+  if(!started) {
+    // cycle counter of the Data Watchpoint and Trace unit: enabled through the trace block
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    started = true;
+  }
+  uint32_t now = DWT->CYCCNT;
+  if(now < last) {
+    wraps += (stage_time_t)1 << 32;
+  }
+  last = now;
+  return wraps + now;
+#else
+  static rtimer_clock_t last;
+  static stage_time_t wraps;
+  rtimer_clock_t now = RTIMER_NOW();
+  if(now < last) {
+    wraps += (stage_time_t)1 << (8 * sizeof(rtimer_clock_t));
+  }
+  last = now;
+  return wraps + now;
+#endif
+}
+
+void stage_timing_add(stage_t stage, stage_time_t start) {
+  stage_time_t elapsed = stage_timing_now() - start;
+  stage_stats_t *s = &stages[stage];
+  if(s->calls++ == 0 || elapsed < s->min) {
+    s->min = (uint32_t)elapsed;
+  }
+  s->total += elapsed;
+  if(elapsed > s->max) {
+    s->max = (uint32_t)elapsed;
+  }
+}
+
+void stage_timing_iteration(void) {
+  if(iterations++ == 0) {
+    first_iteration = stage_timing_now();
+  }
+}
+
+void stage_timing_report(void) {
+  stage_time_t elapsed = stage_timing_now() - first_iteration;
+  uint64_t total = 0;
+  for(int i = 0; i < STAGE_COUNT; i++) {
+    total += stages[i].total;
+  }
+  LOG_INFO("Loop: %lu iterations in %lu ms, %lu iterations/s\n", (unsigned long)iterations,
+           (unsigned long)(elapsed * 1000 / STAGE_TIME_SECOND),
+           elapsed ? (unsigned long)(iterations * STAGE_TIME_SECOND / elapsed) : 0UL);
+  for(int i = 0; i < STAGE_COUNT; i++) {
+    const stage_stats_t *s = &stages[i];
+    LOG_INFO("Stage %-9s: %8lu calls, min %6lu, avg %6lu, max %8lu %s, %3lu%% of the staged time\n", stage_names[i],
+             (unsigned long)s->calls, (unsigned long)s->min, s->calls ? (unsigned long)(s->total / s->calls) : 0UL,
+             (unsigned long)s->max, STAGE_TIME_UNIT, total ? (unsigned long)(s->total * 100 / total) : 0UL);
+  }
+}
+
+void stage_timing_snapshot(stage_snapshot_t *snapshot) {
+  snapshot->iterations = iterations;
+  memcpy(snapshot->stages, stages, sizeof(stages));
+}
+
+void stage_timing_write(const stage_snapshot_t *snapshot, senml_writer *w) {
+  char entry[96]; // longest entry: ,"inference":[<4 x 10 digits>]
+  int len = snprintf(entry, sizeof(entry), "{\"u\":\"%s\",\"hz\":%lu,\"it\":%lu", STAGE_TIME_UNIT,
+                     (unsigned long)STAGE_TIME_SECOND, (unsigned long)snapshot->iterations);
+  senml_writer_put(w, entry, len);
+  for(int i = 0; i < STAGE_COUNT; i++) {
+    const stage_stats_t *s = &snapshot->stages[i];
+    len = snprintf(entry, sizeof(entry), ",\"%s\":[%lu,%lu,%lu,%lu]",
+                   stage_names[i], (unsigned long)s->calls, (unsigned long)s->min,
+                   s->calls ? (unsigned long)(s->total / s->calls) : 0UL, (unsigned long)s->max);
+    senml_writer_put(w, entry, len);
+  }
+  senml_writer_puts(w, "}");
+}
+
+#endif /* STAGE_TIMING */
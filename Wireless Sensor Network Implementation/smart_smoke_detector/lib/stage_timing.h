@@ -0,0 +1,89 @@
+#ifndef STAGE_TIMING_H
+#define STAGE_TIMING_H
+
+#include <stdint.h>
+#include "contiki.h" // for ENERGEST_CONF_ON
+#include "lib/senml_series.h" // for senml_writer
+
+/* Time breakdown of the detector hot path by stage (on by default, make STAGE_TIMING=0 to drop it):
+*  calls, total, min and max time of every stage, plus the loop iterations, served by /metrics.
+*  Time source: DWT cycle counter on the nRF52840, CLOCK_MONOTONIC nanoseconds on the native
+*  target, RTIMER ticks on the other motes (Cooja).
+*/
+
+#ifndef STAGE_TIMING
+#define STAGE_TIMING 0
+#endif
+
+/* stage, Energest type it is accounted to (common/energy.h) */
+#define STAGE_TABLE(X) \
+  X(simulate,  SENSING)   /* new measurements: sensor_sim or trace row */        \
+  X(update,    SENSING)   /* sensor series update */                             \
+  X(trend,     INFERENCE) /* trend detection */                                  \
+  X(inference, INFERENCE) /* fire model */                                       \
+  X(trigger,   NOTIFY)    /* observer notifications */                           \
+  X(serialize, ENCODING)  /* SenML encoding of the sensor payloads (GET and notifications) */
+
+#define STAGE_ENUM(name, energest) STAGE_##name,
+typedef enum { STAGE_TABLE(STAGE_ENUM) STAGE_COUNT } stage_t;
+#undef STAGE_ENUM
+
+typedef struct {
+    uint32_t calls;
+    uint64_t total;
+    uint32_t min;
+    uint32_t max;
+} stage_stats_t;
+
+/* Energest accounting of the stages (ENERGEST_CONF_ON, project-conf.h), also without STAGE_TIMING.
+*  The types are exclusive: a stage nested in a stage of another type (serialize inside trigger, the
+*  notifications encode their payloads) pauses the outer type until it ends, so the per-type times
+*  add up to the CPU time spent in the stages.
+*/
+#if ENERGEST_CONF_ON
+#include "sys/energest.h"
+extern const energest_type_t stage_energest[STAGE_COUNT];
+void stage_energest_on(stage_t stage);
+void stage_energest_off(stage_t stage);
+#define STAGE_ENERGEST_ON(name) stage_energest_on(STAGE_##name)
+#define STAGE_ENERGEST_OFF(name) stage_energest_off(STAGE_##name)
+#else
+#define STAGE_ENERGEST_ON(name)
+#define STAGE_ENERGEST_OFF(name)
+#endif
+
+#if STAGE_TIMING
+typedef uint64_t stage_time_t;
+
+stage_time_t stage_timing_now(void);
+void stage_timing_add(stage_t stage, stage_time_t start);
+void stage_timing_iteration(void);
+
+// log of the iterations per second and of the stage breakdown since the first iteration
+void stage_timing_report(void);
+
+/* Copy of the counters: the Block2 chunks of one /metrics transfer are all written from the
+*  snapshot taken for its first block, so they never mix counters of different iterations.
+*/
+typedef struct {
+    uint32_t iterations;
+    stage_stats_t stages[STAGE_COUNT];
+} stage_snapshot_t;
+
+void stage_timing_snapshot(stage_snapshot_t *snapshot);
+
+/* Compact JSON of a snapshot (/metrics), stage: [calls, min, avg, max] in 'u' units,
+*  'hz' units per second, through the windowed writer of lib/senml_series.h.
+*/
+void stage_timing_write(const stage_snapshot_t *snapshot, senml_writer *w);
+
+#define STAGE_BEGIN(name, var) STAGE_ENERGEST_ON(name); stage_time_t var = stage_timing_now()
+#define STAGE_END(name, var) stage_timing_add(STAGE_##name, var); STAGE_ENERGEST_OFF(name)
+#define STAGE_ITERATION() stage_timing_iteration()
+#else
+#define STAGE_BEGIN(name, var) STAGE_ENERGEST_ON(name)
+#define STAGE_END(name, var) STAGE_ENERGEST_OFF(name)
+#define STAGE_ITERATION()
+#endif
+
+#endif // STAGE_TIMING_H
@@ -0,0 +1,41 @@
+#include "lib/status_group.h"
+
+#if STATUS_GROUP
+#include "contiki.h"
+#include "coap-engine.h"
+#include "coap.h"
+#include "sys/log.h"
+#include <string.h> // for strlen
+
+#define LOG_MODULE "SSD-Group"
+#define LOG_LEVEL LOG_LEVEL_APP
+
+static coap_endpoint_t group_ep;
+static coap_message_t group_msg[1];
+static uint8_t group_buf[COAP_MAX_PACKET_SIZE];
+
+int status_group_init(void) {
+  if(coap_endpoint_parse(STATUS_GROUP_EP, strlen(STATUS_GROUP_EP), &group_ep) == 0) {
+    LOG_ERR("Failed to parse group endpoint: %s\n", STATUS_GROUP_EP);
+    return -1;
+  }
+  LOG_INFO("Status changes sent to group %s\n", STATUS_GROUP_EP);
+  return 0;
+}
+
+void status_group_send(const char *payload, int len) {
+  // non-confirmable: multicast requests are never acknowledged, the multicast engine repeats them
+  coap_init_message(group_msg, COAP_TYPE_NON, COAP_PUT, coap_get_mid());
+  coap_set_header_uri_path(group_msg, STATUS_GROUP_PATH);
+  coap_set_header_content_format(group_msg, APPLICATION_JSON);
+  coap_set_payload(group_msg, (const uint8_t *)payload, len);
+
+  size_t msg_len = coap_serialize_message(group_msg, group_buf);
+  if(msg_len == 0) {
+    LOG_ERR("Status group message too large\n");
+    return;
+  }
+  coap_sendto(&group_ep, group_buf, msg_len);
+  LOG_DBG("Status sent to group: %.*s\n", len, payload);
+}
+#endif
@@ -0,0 +1,30 @@
+#ifndef STATUS_GROUP_H
+#define STATUS_GROUP_H
+
+/* CoAP group communication of the status (make STATUS_GROUP=1, RFC 7252 section 8):
+*  every status change is also sent once as a NON PUT /STATUS_GROUP_PATH to the site-local
+*  multicast group STATUS_GROUP_ADDR, carried by the IPv6 multicast engine (MPL, project-conf.h).
+*  The vents of the group apply it without answering, so the alarm fan-out costs the same
+*  transmissions whatever the number of vents, and does not take observer pool entries.
+*  /status stays observable (cloud, vents out of the group).
+*/
+
+#ifndef STATUS_GROUP
+#define STATUS_GROUP 0
+#endif
+
+#ifndef STATUS_GROUP_ADDR
+#define STATUS_GROUP_ADDR "ff05::fd" // All CoAP Nodes, site-local scope (RFC 7252 section 12.8)
+#endif
+#define STATUS_GROUP_EP "coap://[" STATUS_GROUP_ADDR "]:5683"
+#define STATUS_GROUP_PATH "status"
+
+#if STATUS_GROUP
+// parses the group endpoint, -1 on error
+int status_group_init(void);
+
+// sends the status payload (JSON, as served by GET /status) to the group
+void status_group_send(const char *payload, int len);
+#endif
+
+#endif // STATUS_GROUP_H
@@ -0,0 +1,132 @@
+#include "lib/trace_replay.h"
+
+#if SENSOR_TRACE_REPLAY
+
+#include <stdio.h>
+#include "lib/sensor_trace.h"
+#include "sys/log.h"
+
+#define LOG_MODULE "Replay"
+#define LOG_LEVEL LOG_LEVEL_APP
+
+static FILE *trace;
+static sensor_trace_header header;
+static char line[TRACE_REPLAY_LINE_LEN];
+static unsigned long line_no;
+
+int trace_replay_open(const char *path) {
+  const char *missing = NULL;
+  trace = fopen(path, "r");
+  if(!trace) {
+    LOG_ERR("Cannot open trace %s\n", path);
+    return -1;
+  }
+  line_no = 1;
+  if(!fgets(line, sizeof(line), trace) || sensor_trace_parse_header(&header, line, &missing) < 0) {
+    LOG_ERR("%s: no %s column\n", path, missing ? missing : "header");
+    trace_replay_close();
+    return -1;
+  }
+  LOG_INFO("Replaying %s%s\n", path, (header.label_column < 0) ? " (no Fire Alarm column, not scored)" : "");
+  return 0;
+}
+
+bool trace_replay_next(sensor_sim_t *sensors, int *label, uint32_t *utc) {
+  while(trace && fgets(line, sizeof(line), trace)) {
+    line_no++;
+    if(sensor_trace_parse_row(&header, line, sensors, label, utc) == 0) {
+      return true;
+    }
+    LOG_WARN("Trace line %lu: short line, skipped\n", line_no);
+  }
+  return false;
+}
+
+void trace_replay_close(void) {
+  if(trace) {
+    fclose(trace);
+    trace = NULL;
+  }
+}
+
+void trace_replay_score(trace_replay_stats *stats, int label, uint32_t utc, unsigned int status,
+                        clock_time_t pipeline_ticks) {
+  bool alarm = (status == 1);
+
+  stats->rows++;
+  stats->pipeline_ticks += pipeline_ticks;
+  if(pipeline_ticks > stats->pipeline_ticks_max) {
+    stats->pipeline_ticks_max = pipeline_ticks;
+  }
+
+  if(label >= 0) {
+    stats->labelled++;
+    if(alarm) {
+      if(label) stats->tp++; else stats->fp++;
+    } else {
+      if(label) stats->fn++; else stats->tn++;
+    }
+
+    if(label && !stats->in_fire) {
+      stats->in_fire = true;
+      stats->detected = false;
+      stats->fire_row = stats->rows;
+      stats->fire_utc = utc;
+      stats->fires++;
+    } else if(!label) {
+      stats->in_fire = false;
+    }
+
+    if(alarm && !stats->alarm) {
+      if(stats->in_fire && !stats->detected) {
+        uint32_t rows = stats->rows - stats->fire_row;
+        uint32_t seconds = (utc >= stats->fire_utc) ? utc - stats->fire_utc : 0;
+        stats->detected = true;
+        stats->fires_detected++;
+        stats->latency_rows_sum += rows;
+        stats->latency_s_sum += seconds;
+        if(rows > stats->latency_rows_max) stats->latency_rows_max = rows;
+        if(seconds > stats->latency_s_max) stats->latency_s_max = seconds;
+        LOG_INFO("Fire episode %lu detected after %lu rows, %lu s\n", (unsigned long)stats->fires,
+                 (unsigned long)rows, (unsigned long)seconds);
+      } else if(!stats->in_fire) {
+        stats->false_alarms++;
+        LOG_INFO("False alarm at row %lu\n", (unsigned long)stats->rows);
+      }
+    }
+  }
+  stats->alarm = alarm;
+}
+
+// percentage with one decimal, no float formatting in the Contiki printf
+static void log_ratio(const char *name, uint32_t num, uint32_t den) {
+  unsigned long permille = den ? (unsigned long)((1000ULL * num + den / 2) / den) : 0;
+  LOG_INFO("  %-14s: %lu.%lu%% (%lu/%lu)\n", name, permille / 10, permille % 10, (unsigned long)num, (unsigned long)den);
+}
+
+void trace_replay_report(const trace_replay_stats *stats) {
+  LOG_INFO("Trace replay done: %lu rows\n", (unsigned long)stats->rows);
+  if(stats->rows) {
+    LOG_INFO("  pipeline      : %lu ticks total, max %lu per row (CLOCK_SECOND %lu)\n",
+             (unsigned long)stats->pipeline_ticks, (unsigned long)stats->pipeline_ticks_max,
+             (unsigned long)CLOCK_SECOND);
+  }
+  if(!stats->labelled) {
+    return;
+  }
+  LOG_INFO("  confusion     : tp %lu fp %lu fn %lu tn %lu\n", (unsigned long)stats->tp, (unsigned long)stats->fp,
+           (unsigned long)stats->fn, (unsigned long)stats->tn);
+  log_ratio("accuracy", stats->tp + stats->tn, stats->labelled);
+  log_ratio("precision", stats->tp, stats->tp + stats->fp);
+  log_ratio("recall", stats->tp, stats->tp + stats->fn);
+  LOG_INFO("  fire episodes : %lu, detected %lu, false alarms %lu\n", (unsigned long)stats->fires,
+           (unsigned long)stats->fires_detected, (unsigned long)stats->false_alarms);
+  if(stats->fires_detected) {
+    LOG_INFO("  alarm latency : avg %lu rows / %lu s, max %lu rows / %lu s\n",
+             (unsigned long)(stats->latency_rows_sum / stats->fires_detected),
+             (unsigned long)(stats->latency_s_sum / stats->fires_detected),
+             (unsigned long)stats->latency_rows_max, (unsigned long)stats->latency_s_max);
+  }
+}
+
+#endif /* SENSOR_TRACE_REPLAY */
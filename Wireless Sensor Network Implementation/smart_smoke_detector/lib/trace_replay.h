@@ -0,0 +1,63 @@
+#ifndef TRACE_REPLAY_H
+#define TRACE_REPLAY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "contiki.h"
+#include "lib/sensor_sim.h"
+
+/* Trace replay (make TARGET=native TRACE=<csv>): the detector loop reads its measurements from a
+*  recorded sensor trace (lib/sensor_trace.h, e.g. the Kaggle dataset) instead of sensor_sim, one row
+*  every SENSOR_TRACE_PERIOD, and scores its status against the Fire Alarm column of the rows:
+*    - per-row confusion matrix of status 1 (fire) vs Fire Alarm
+*    - alarm timing: rows and trace seconds (UTC column) from the start of every ground-truth fire
+*      episode to the fire status, missed episodes, false alarms (fire status outside an episode)
+*    - pipeline time: sensor resources update, trend and fire assessment of one row
+*  Native target only (stdio file access).
+*/
+
+#ifndef SENSOR_TRACE_REPLAY
+#define SENSOR_TRACE_REPLAY 0
+#endif
+
+#ifndef SENSOR_TRACE_PERIOD
+#define SENSOR_TRACE_PERIOD (CLOCK_SECOND / 100) // between two replayed rows
+#endif
+
+#define TRACE_REPLAY_LINE_LEN 512
+
+typedef struct {
+    uint32_t rows;
+    uint32_t labelled;                    // rows with a Fire Alarm value
+    uint32_t tp, fp, fn, tn;              // status 1 vs Fire Alarm, per row
+    uint32_t fires;                       // ground-truth fire episodes (Fire Alarm 0 -> 1)
+    uint32_t fires_detected;              // ... with a fire status before their end
+    uint32_t false_alarms;                // fire status raised outside an episode
+    uint32_t latency_rows_sum, latency_rows_max;  // episode start -> fire status
+    uint32_t latency_s_sum, latency_s_max;        // same, trace UTC seconds
+    clock_time_t pipeline_ticks;          // total pipeline time of the rows
+    clock_time_t pipeline_ticks_max;
+
+    // current episode
+    bool in_fire;
+    bool detected;
+    bool alarm;                           // previous row status was 1
+    uint32_t fire_row;
+    uint32_t fire_utc;
+} trace_replay_stats;
+
+// opens the trace and reads its header, returns -1 (and logs why) on error
+int trace_replay_open(const char *path);
+
+// next measurement of the trace into sensors: returns false at the end of the trace
+bool trace_replay_next(sensor_sim_t *sensors, int *label, uint32_t *utc);
+
+void trace_replay_close(void);
+
+// scores the status decided for the row, pipeline_ticks: time spent on it
+void trace_replay_score(trace_replay_stats *stats, int label, uint32_t utc, unsigned int status,
+                        clock_time_t pipeline_ticks);
+
+void trace_replay_report(const trace_replay_stats *stats);
+
+#endif // TRACE_REPLAY_H
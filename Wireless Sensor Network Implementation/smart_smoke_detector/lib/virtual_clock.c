@@ -0,0 +1,5 @@
+#include "lib/virtual_clock.h"
+
+#if VIRTUAL_TIME
+clock_time_t virtual_clock_ticks = 0;
+#endif
@@ -0,0 +1,30 @@
+#ifndef VIRTUAL_CLOCK_H
+#define VIRTUAL_CLOCK_H
+
+#include "os/sys/clock.h"
+
+/* Clock of the detector logic (measurement timestamps, notification gaps, detection latency).
+*  VIRTUAL_TIME (make TARGET=native VIRTUAL_TIME=1): time only advances when the detector loop
+*  moves it by one sensing period, so the loop runs as fast as the CPU allows while every
+*  time-based decision sees the scenario time. Otherwise the Contiki clock.
+*/
+
+#ifndef VIRTUAL_TIME
+#define VIRTUAL_TIME 0
+#endif
+
+#if VIRTUAL_TIME
+extern clock_time_t virtual_clock_ticks;
+
+#define vclock_time() (virtual_clock_ticks)
+#define vclock_seconds() ((unsigned long)(virtual_clock_ticks / CLOCK_SECOND))
+
+static inline void virtual_clock_advance(clock_time_t ticks) {
+  virtual_clock_ticks += ticks;
+}
+#else
+#define vclock_time() clock_time()
+#define vclock_seconds() clock_seconds()
+#endif
+
+#endif // VIRTUAL_CLOCK_H
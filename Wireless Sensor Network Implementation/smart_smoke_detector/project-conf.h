@@ -6,12 +6,22 @@
 
 #define LOG_LEVEL_APP LOG_LEVEL_DBG
 
-//#if COOJA
-//  #define COAP_MAX_OBSERVERS 12  // For COOJA
-//#else
-#define COAP_MAX_OBSERVERS 4
-//#endif
+// observers of all the resources share one pool, see lib/observer_pool.h
+// (make OBSERVER_POOL_SIZE=<n> to size it)
+#ifndef OBSERVER_POOL_SIZE
+#define OBSERVER_POOL_SIZE 12
+#endif
+#define COAP_MAX_OBSERVERS OBSERVER_POOL_SIZE
 
 #define REST_MAX_CHUNK_SIZE 256
 
+// energy accounting (common/energy.h): Energest with the application stages as types of their own
+#define ENERGEST_CONF_ON 1
+#define ENERGEST_CONF_ADDITIONS ENERGEST_TYPE_SENSING, ENERGEST_TYPE_INFERENCE, ENERGEST_TYPE_ENCODING, ENERGEST_TYPE_NOTIFY
+
+// status group (make STATUS_GROUP=1): multicast forwarding independent of the RPL mode
+#if STATUS_GROUP
+#define UIP_MCAST6_CONF_ENGINE UIP_MCAST6_ENGINE_MPL
+#endif
+
 #endif /* PROJECT_CONF_H_ */
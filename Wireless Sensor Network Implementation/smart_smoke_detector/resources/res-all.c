@@ -0,0 +1,35 @@
+#include "contiki.h"
+#include "coap-engine.h"
+#include "lib/senml_series.h"
+#include "lib/senml_coap.h"
+#include "lib/sensor_table.h"
+#include "lib/notify_limiter.h"
+#include "lib/observer_pool.h"
+#include "lib/sensing_period.h"
+
+static void res_get_handler(coap_message_t *request, coap_message_t *response,
+                            uint8_t *buffer, uint16_t preferred_size, int32_t *offset);
+static void res_event_handler(void);
+
+
+EVENT_RESOURCE(res_all,
+		  "title=\"All sensors: ?n=0..\";rt=\"urn:ietf:senml:pack\";ct=\"50 112\";obs", // one SenML pack with the windows of all the sensor table series, shared base time
+		  res_get_handler,
+		  NULL,
+		  NULL,
+		  NULL,
+		  res_event_handler);
+
+
+extern sensing_period_t sensing;
+
+static void res_event_handler(void) {
+  notify_limiter_request(&res_all);
+}
+
+
+static void res_get_handler(coap_message_t *request, coap_message_t *response, uint8_t *buffer, uint16_t preferred_size, int32_t *offset) {
+  observer_pool_admit(request);
+  senml_pack_get_handler(sensor_series, SENSOR_COUNT, request, response, buffer, preferred_size, offset);
+  coap_set_header_max_age(response, sensing.period); // fresh until the next measurement
+}
@@ -0,0 +1,43 @@
+#include <stdio.h> // for snprintf
+#include "contiki.h"
+#include "coap-engine.h"
+#include "lib/senml_series.h"
+#include "lib/sensing_period.h"
+#include "lib/notify_limiter.h"
+#include "energy.h"
+
+#if ENERGEST_CONF_ON
+extern sensing_period_t sensing;
+
+static void res_get_handler(coap_message_t *request, coap_message_t *response,
+                            uint8_t *buffer, uint16_t preferred_size, int32_t *offset);
+static void res_event_handler(void);
+
+EVENT_RESOURCE(res_energy,
+               "title=\"Energy per subsystem\";rt=\"energy\";obs",
+               res_get_handler,
+               NULL,
+               NULL,
+               NULL,
+               res_event_handler);
+
+static void res_event_handler(void) {
+  notify_limiter_request(&res_energy);
+}
+
+static void res_get_handler(coap_message_t *request, coap_message_t *response,
+                            uint8_t *buffer, uint16_t preferred_size, int32_t *offset) {
+  int len = snprintf((char *)buffer, preferred_size, "{\"bn\":\"%senergy\",\"period\":%u,\"n\":%lu,",
+                     BASE_NAME, sensing.period, (unsigned long)energy_last_window()->reports);
+  if(len > 0 && len < preferred_size) {
+    len += energy_serialize((char *)buffer + len, preferred_size - len);
+  }
+  if(len < 0 || len + 1 >= preferred_size) {
+    coap_set_status_code(response, INTERNAL_SERVER_ERROR_5_00);
+    return;
+  }
+  buffer[len++] = '}';
+  coap_set_header_content_format(response, APPLICATION_JSON);
+  coap_set_payload(response, buffer, len);
+}
+#endif
@@ -0,0 +1,53 @@
+#include <stdio.h> // for snprintf
+#include "contiki.h"
+#include "coap-engine.h"
+#include "lib/senml_series.h"
+#include "lib/stage_timing.h"
+
+#if STAGE_TIMING
+static void res_get_handler(coap_message_t *request, coap_message_t *response,
+                            uint8_t *buffer, uint16_t preferred_size, int32_t *offset);
+
+/* Hot path stage breakdown (lib/stage_timing.h): per stage [calls, min, avg, max] */
+RESOURCE(res_metrics,
+         "title=\"Hot path stage timing: stage [calls, min, avg, max]\";rt=\"metrics\"",
+         res_get_handler,
+         NULL,
+         NULL,
+         NULL);
+
+/* Counters served by the current transfer: taken on its first block, the later blocks are cut
+*  from the same document instead of a fresh one.
+*/
+static stage_snapshot_t snapshot;
+static unsigned long snapshot_uptime;
+
+static void res_get_handler(coap_message_t *request, coap_message_t *response,
+                            uint8_t *buffer, uint16_t preferred_size, int32_t *offset) {
+  int32_t block_offset = offset ? *offset : 0;
+  if(block_offset == 0) {
+    stage_timing_snapshot(&snapshot);
+    snapshot_uptime = clock_seconds();
+  }
+
+  char uptime[24];
+  senml_writer w;
+  senml_writer_init(&w, buffer, preferred_size, block_offset);
+  senml_writer_puts(&w, "{\"bn\":\"" BASE_NAME "metrics\",\"uptime\":");
+  senml_writer_put(&w, uptime, snprintf(uptime, sizeof(uptime), "%lu,\"st\":", snapshot_uptime));
+  stage_timing_write(&snapshot, &w);
+  senml_writer_puts(&w, "}");
+
+  if(block_offset > 0 && block_offset >= w.pos) {
+    coap_set_status_code(response, BAD_OPTION_4_02);
+    coap_set_payload(response, "Block out of scope", 18);
+    return;
+  }
+  int chunk = senml_writer_written(&w);
+  coap_set_header_content_format(response, APPLICATION_JSON);
+  coap_set_payload(response, buffer, chunk);
+  if(offset) {
+    *offset = (block_offset + chunk < w.pos) ? block_offset + chunk : -1; // -1 marks the last block
+  }
+}
+#endif
@@ -0,0 +1,35 @@
+#include <stdio.h> // for snprintf
+#include "contiki.h"
+#include "coap-engine.h"
+#include "lib/virtual_clock.h"
+#include "lib/senml_series.h"
+#include "lib/notify_limiter.h"
+
+static void res_get_handler(coap_message_t *request, coap_message_t *response,
+                            uint8_t *buffer, uint16_t preferred_size, int32_t *offset);
+
+RESOURCE(res_notifications,
+         "title=\"Notification limiter counters\";rt=\"notifications\"",
+         res_get_handler,
+         NULL,
+         NULL,
+         NULL);
+
+static void res_get_handler(coap_message_t *request, coap_message_t *response,
+                            uint8_t *buffer, uint16_t preferred_size, int32_t *offset) {
+  const notify_limiter_stats_t *stats = notify_limiter_stats();
+  int len = snprintf((char *)buffer, preferred_size,
+                     "{\"bn\":\"%snotifications\",\"gap\":%lu,\"requested\":%lu,\"sent\":%lu,"
+                     "\"delayed\":%lu,\"coalesced\":%lu,\"bypassed\":%lu,\"dropped\":%lu,\"uptime\":%lu}",
+                     BASE_NAME, (unsigned long)(NOTIFY_MIN_GAP * 1000UL / CLOCK_SECOND),
+                     (unsigned long)stats->requested, (unsigned long)stats->sent,
+                     (unsigned long)stats->delayed, (unsigned long)stats->coalesced,
+                     (unsigned long)stats->bypassed, (unsigned long)stats->dropped,
+                     (unsigned long)vclock_seconds());
+  if(len < 0 || len >= preferred_size) {
+    coap_set_status_code(response, INTERNAL_SERVER_ERROR_5_00);
+    return;
+  }
+  coap_set_header_content_format(response, APPLICATION_JSON);
+  coap_set_payload(response, buffer, len);
+}
@@ -0,0 +1,35 @@
+#include <stdio.h> // for snprintf
+#include "contiki.h"
+#include "coap-engine.h"
+#include "lib/virtual_clock.h"
+#include "lib/senml_series.h"
+#include "lib/observer_pool.h"
+
+static void res_get_handler(coap_message_t *request, coap_message_t *response,
+                            uint8_t *buffer, uint16_t preferred_size, int32_t *offset);
+
+RESOURCE(res_observers,
+         "title=\"Observer pool counters\";rt=\"observers\"",
+         res_get_handler,
+         NULL,
+         NULL,
+         NULL);
+
+static void res_get_handler(coap_message_t *request, coap_message_t *response,
+                            uint8_t *buffer, uint16_t preferred_size, int32_t *offset) {
+  const observer_pool_stats_t *stats = observer_pool_stats();
+  int pinned;
+  int used = observer_pool_used(&pinned);
+  int len = snprintf((char *)buffer, preferred_size,
+                     "{\"bn\":\"%sobservers\",\"pool\":%u,\"used\":%d,\"pinned\":%d,\"peak\":%u,"
+                     "\"registrations\":%lu,\"evicted\":%lu,\"rejected\":%lu,\"uptime\":%lu}",
+                     BASE_NAME, (unsigned)OBSERVER_POOL_SIZE, used, pinned, (unsigned)stats->peak,
+                     (unsigned long)stats->registrations, (unsigned long)stats->evicted,
+                     (unsigned long)stats->rejected, (unsigned long)vclock_seconds());
+  if(len < 0 || len >= preferred_size) {
+    coap_set_status_code(response, INTERNAL_SERVER_ERROR_5_00);
+    return;
+  }
+  coap_set_header_content_format(response, APPLICATION_JSON);
+  coap_set_payload(response, buffer, len);
+}
@@ -0,0 +1,60 @@
+#include <stdlib.h> // for atoi
+#include <stdio.h> // for snprintf
+#include "contiki.h"
+#include "coap-engine.h"
+#include "lib/virtual_clock.h"
+#include "lib/senml_series.h"
+#include "lib/sensing_period.h"
+
+static void res_get_handler(coap_message_t *request, coap_message_t *response,
+                            uint8_t *buffer, uint16_t preferred_size, int32_t *offset);
+
+static void res_post_put_handler(coap_message_t *request, coap_message_t *response,
+                                 uint8_t *buffer, uint16_t preferred_size, int32_t *offset);
+
+RESOURCE(res_sensing,
+         "title=\"Sensing period: POST/PUT min=<sec>&max=<sec>\";rt=\"sensing\"",
+         res_get_handler,
+         res_post_put_handler,
+         res_post_put_handler,
+         NULL);
+
+sensing_period_t sensing; // adaptive sensing period, updated by the main loop
+
+static void res_get_handler(coap_message_t *request, coap_message_t *response,
+                            uint8_t *buffer, uint16_t preferred_size, int32_t *offset) {
+  int len = snprintf((char *)buffer, preferred_size,
+                     "{\"bn\":\"%ssensing\",\"min\":%u,\"max\":%u,\"period\":%u,"
+                     "\"samples\":%lu,\"shortened\":%lu,\"latency\":%lu,\"uptime\":%lu}",
+                     BASE_NAME, sensing.min, sensing.max, sensing.period,
+                     (unsigned long)sensing.samples, (unsigned long)sensing.shortened,
+                     (unsigned long)sensing.detection_latency, (unsigned long)vclock_seconds());
+  if(len < 0 || len >= preferred_size) {
+    coap_set_status_code(response, INTERNAL_SERVER_ERROR_5_00);
+    return;
+  }
+  coap_set_header_content_format(response, APPLICATION_JSON);
+  coap_set_payload(response, buffer, len);
+}
+
+static void res_post_put_handler(coap_message_t *request, coap_message_t *response,
+                                 uint8_t *buffer, uint16_t preferred_size, int32_t *offset) {
+  const char *text = NULL;
+  int min = sensing.min;
+  int max = sensing.max;
+  bool found = false;
+
+  if(coap_get_post_variable(request, "min", &text)) {
+    min = atoi(text);
+    found = true;
+  }
+  if(coap_get_post_variable(request, "max", &text)) {
+    max = atoi(text);
+    found = true;
+  }
+  if(found && sensing_period_set_bounds(&sensing, min, max)) {
+    coap_set_status_code(response, CHANGED_2_04);
+  } else {
+    coap_set_status_code(response, BAD_REQUEST_4_00);
+  }
+}
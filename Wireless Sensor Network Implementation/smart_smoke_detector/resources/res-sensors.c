@@ -0,0 +1,97 @@
+#include <stdlib.h> // for atoi
+#include "contiki.h"
+#include "coap-engine.h"
+#include "lib/sensor_table.h"
+#include "lib/senml_coap.h"
+#include "lib/sensing_period.h"
+#include "lib/observer_pool.h"
+
+static void res_get_handler(coap_message_t *request, coap_message_t *response,
+                            uint8_t *buffer, uint16_t preferred_size, int32_t *offset);
+
+static void res_post_put_handler(coap_message_t *request, coap_message_t *response, uint8_t *buffer, uint16_t preferred_size, int32_t *offset);
+
+/* One observable resource per sensor table row, all served by the same handlers (the row is found
+*  from the Uri-Path). Notifications are sent by the main loop through the notification limiter
+*  (lib/notify_limiter.h), according to the notification policy of the row (POST/PUT deadband=, max_interval=).
+*  Custom-compliant resource type(rt); ct=50/112: CoAP content-format numbers for SenML JSON/CBOR encoding
+*/
+#define SENSOR_RESOURCE(id, field, title, rt, unit, type, scale, offset, change, deadband, mean, sd, feature, limit, max) \
+  EVENT_RESOURCE(res_##id,                                                                      \
+		  "title=\"" title "\";rt=\"urn:ietf:senml:json:" rt "\";ct=\"50 112\";obs",             \
+		  res_get_handler,                                                                      \
+		  res_post_put_handler,                                                                 \
+		  res_post_put_handler,                                                                 \
+		  NULL,                                                                                 \
+		  NULL);
+SENSOR_TABLE(SENSOR_RESOURCE)
+#undef SENSOR_RESOURCE
+
+extern sensing_period_t sensing;
+
+
+static const sensor_desc_t *request_sensor(coap_message_t *request) {
+  const char *path = NULL;
+  int len = coap_get_header_uri_path(request, &path);
+  return sensor_by_name(path, len);
+}
+
+static void res_get_handler(coap_message_t *request, coap_message_t *response, uint8_t *buffer, uint16_t preferred_size, int32_t *offset) {
+  const sensor_desc_t *desc = request_sensor(request);
+  if(!desc) {
+    coap_set_status_code(response, NOT_FOUND_4_04);
+    return;
+  }
+  observer_pool_admit(request);
+  senml_series_get_handler(desc->series, request, response, buffer, preferred_size, offset);
+  coap_set_header_max_age(response, sensing.period); // fresh until the next measurement
+}
+
+static void res_post_put_handler(coap_message_t *request, coap_message_t *response, uint8_t *buffer, uint16_t preferred_size, int32_t *offset) {
+  const sensor_desc_t *desc = request_sensor(request);
+  if(!desc) {
+    coap_set_status_code(response, NOT_FOUND_4_04);
+    return;
+  }
+  int row = desc - sensor_table;
+  notify_policy_t *policy = &sensor_notify[row];
+  int32_t deadband = policy->deadband;
+  int max_interval = policy->max_interval;
+  bool found = false;
+
+  const char *text = NULL;
+  if(coap_get_post_variable(request, "limit", &text)){
+    if(desc->limit_default == 0) {
+      coap_set_status_code(response, BAD_REQUEST_4_00);
+      return;
+    }
+    int limit = atoi(text);
+    if(limit < 0) { limit = 0; }
+    else if (limit > desc->limit_max) { limit = desc->limit_max; }
+    
+    sensor_limit[row] = limit;
+    found = true;
+  }
+  // notification policy: deadband < 0 restores the buffer cycle policy
+  if(coap_get_post_variable(request, "deadband", &text)){
+    deadband = atoi(text);
+    if(deadband < 0) { deadband = NOTIFY_POLICY_CYCLE; }
+    found = true;
+  }
+  if(coap_get_post_variable(request, "max_interval", &text)){
+    max_interval = atoi(text);
+    if(max_interval < 0 || max_interval > NOTIFY_MAX_INTERVAL_LIMIT) {
+      coap_set_status_code(response, BAD_REQUEST_4_00);
+      return;
+    }
+    found = true;
+  }
+  if(!found) {
+    coap_set_status_code(response, BAD_REQUEST_4_00);
+    return;
+  }
+  if(deadband != policy->deadband || max_interval != policy->max_interval) {
+    notify_policy_init(policy, deadband, (uint16_t)max_interval); // next sample is notified
+  }
+  coap_set_status_code(response, CHANGED_2_04);
+}
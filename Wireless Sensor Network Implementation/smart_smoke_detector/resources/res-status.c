@@ -2,7 +2,11 @@
 #include <stdio.h> // for snprintf
 #include "contiki.h"
 #include "coap-engine.h"
+#include "lib/virtual_clock.h"
 #include "lib/senml_series.h"
+#include "lib/notify_limiter.h"
+#include "lib/observer_pool.h"
+#include "lib/status_group.h"
 
 static void res_get_handler(coap_message_t *request, coap_message_t *response,
                             uint8_t *buffer, uint16_t preferred_size, int32_t *offset);
@@ -20,17 +24,43 @@ EVENT_RESOURCE(res_status,
 
 unsigned int status = 0;
 
+/* Status change stamping for the end-to-end alarm latency measured by the vent:
+*  sequence number of the change and detector time (ms) it originated at. "now" in the payload
+*  is the detector time of the response, used by the observers to align their clocks.
+*/
+static uint16_t status_seq = 0;
+static uint32_t status_origin_ms = 0;
+
+static uint32_t status_clock_ms(void) {
+  return (uint32_t)((uint64_t)clock_time() * 1000 / CLOCK_SECOND);
+}
+
+void status_stamp(void) {
+  status_seq++;
+  status_origin_ms = status_clock_ms();
+}
+
+static int status_payload(char *payload, int size) {
+  return snprintf(payload, size,
+                  "{\"bn\": \"%sstatus\", \"status\": %u, \"bt\": %lu, \"seq\": %u, \"ts\": %lu, \"now\": %lu}",
+                  BASE_NAME, status, (unsigned long)vclock_seconds(),
+                  status_seq, (unsigned long)status_origin_ms, (unsigned long)status_clock_ms());
+}
+
 static void res_event_handler(void) {
-  coap_notify_observers(&res_status);
+  notify_limiter_bypass(&res_status); // status changes are never delayed
+#if STATUS_GROUP
+  char payload[MAX_PAYLOAD_LEN];
+  status_group_send(payload, status_payload(payload, sizeof(payload)));
+#endif
 }
 
 static void res_get_handler(coap_message_t *request, coap_message_t *response,
                             uint8_t *buffer, uint16_t preferred_size, int32_t *offset) {
   char payload[MAX_PAYLOAD_LEN];
 
-  int len = snprintf(payload, sizeof(payload),
-                     "{\"bn\": \"%sstatus\", \"status\": %u, \"bt\": %lu}", 
-                     BASE_NAME, status, (unsigned long)clock_seconds());
+  observer_pool_admit(request); // status observers are never evicted
+  int len = status_payload(payload, sizeof(payload));
 
   memcpy(buffer, payload, len);
   coap_set_header_content_format(response, APPLICATION_JSON);
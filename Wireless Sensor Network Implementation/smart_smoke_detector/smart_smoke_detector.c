@@ -1,16 +1,25 @@
 #include <stdio.h>
 #include <stdbool.h>
+#include <stdlib.h> // for strtol
+#include <string.h> // for strncmp
 #include "contiki.h"
 #include "coap-engine.h"
 #include "lib/sensor_sim.h"
 #include "lib/smart_smoke_detector_utilities.h"
-#include "lib/features_norm_constants.h"
-#include "fire_detector.h"	// emlearn generated model
+#include "lib/fire_model.h"
+#include "lib/sensing_period.h"
+#include "lib/trace_replay.h"
+#include "lib/virtual_clock.h"
+#include "lib/stage_timing.h"
+#include "lib/notify_limiter.h"
+#include "lib/status_group.h"
+#include "energy.h"
 
 #include "os/dev/button-hal.h"
 #include "os/dev/leds.h"
 #include "sys/etimer.h"
 #include "sys/log.h"
+#include "dev/serial-line.h"
 
 #define LOG_MODULE "SSD"
 #define LOG_LEVEL LOG_LEVEL_APP
@@ -20,71 +29,117 @@
 #define BUTTON_PRESS_TIME_TO_FIRE 2 //sec
 
 /* ---------- Exposed CoAP Resources ---------- */
-extern coap_resource_t  res_temp; 
-extern coap_resource_t  res_hum;
-extern coap_resource_t  res_pressure;
-extern coap_resource_t  res_tvoc;
-extern coap_resource_t  res_raw_h2; 
-extern coap_resource_t  res_raw_ethanol;
-extern coap_resource_t  res_pm1_0;
-extern coap_resource_t  res_pm2_5;
-extern coap_resource_t  res_nc0_5;
+// sensor resources: lib/sensor_table.h
+extern coap_resource_t  res_all;
 
 extern coap_resource_t res_status;
 
+extern coap_resource_t res_sensing;
+
+extern coap_resource_t res_notifications;
+
+extern coap_resource_t res_observers;
+
+#if STAGE_TIMING
+extern coap_resource_t res_metrics;
+#endif
+
+#if ENERGEST_CONF_ON
+extern coap_resource_t res_energy;
+#endif
+
 /* ------ Resources Inner Data Structure ------ */
 extern unsigned int status; // environment state control variable
+extern sensing_period_t sensing; // adaptive sensing period and its bounds
+extern void status_stamp(void); // sequence number and origin time of a status change
 
 /* -------- Simulation Data Structures -------- */
 static sensor_sim_t sensors; // Real Sensors Simulator
 
 static bool simulate_fire_ignition = false; // Fire Env. State Simulator
+static unsigned long fire_ignition_time; // detection latency of the simulated fires
 static bool simulate_hazard_condition = false; // Hazard Env. State Simulator
 
 static bool water_sprinkler = false; // Water Sprinkler Fire Suppression Simulator
 
 static button_hal_button_t *btn; // Fire/Hazard Conditions Input Simulator
 
+#if SENSOR_TRACE_REPLAY
+/* ------------ Trace Replay Source ----------- */
+static trace_replay_stats replay; // status vs ground truth of the replayed rows
+#endif
+
 /* ----------- Logic Data Structure ----------- */
 static struct etimer e_sensing_timer;
 
+#if VIRTUAL_TIME
+/* Virtual time (lib/virtual_clock.h): no timer, the process polls itself for the next measurement
+*  and moves the clock by the interval. Fire and hazard are simulated at fixed scenario times.
+*/
+#ifndef VIRTUAL_TIME_DURATION
+#define VIRTUAL_TIME_DURATION (24UL * 3600) // sec of scenario
+#endif
+#ifndef VIRTUAL_EPISODE_PERIOD
+#define VIRTUAL_EPISODE_PERIOD 3600UL // sec between two fires (hazards half a period later)
+#endif
+#define VIRTUAL_EPISODE_LEN 120UL // sec
+
+#define SENSING_EVENT(ev, data) ((ev) == PROCESS_EVENT_POLL)
+
+static void schedule_sensing(clock_time_t interval) {
+  virtual_clock_advance(interval);
+  notify_limiter_poll(); // the flush timer runs in real time
+  process_poll(PROCESS_CURRENT());
+}
+
+static void virtual_scenario(unsigned long now) {
+  bool fire = (now % VIRTUAL_EPISODE_PERIOD) < VIRTUAL_EPISODE_LEN;
+  bool hazard = ((now + VIRTUAL_EPISODE_PERIOD / 2) % VIRTUAL_EPISODE_PERIOD) < VIRTUAL_EPISODE_LEN;
+  if(fire && !simulate_fire_ignition) {
+    fire_ignition_time = now;
+  }
+  simulate_fire_ignition = fire;
+  simulate_hazard_condition = hazard;
+}
+#else
+#define SENSING_EVENT(ev, data) ((ev) == PROCESS_EVENT_TIMER && (data) == &e_sensing_timer)
+
+static void schedule_sensing(clock_time_t interval) {
+  etimer_set(&e_sensing_timer, interval);
+}
+#endif
+
 
 static void activate_all_resources(void){
-  coap_activate_resource(&res_temp, "temp");
-  coap_activate_resource(&res_hum,  "hum");
-  coap_activate_resource(&res_pressure,  "pressure");
-  coap_activate_resource(&res_tvoc,  "tvoc");
-  coap_activate_resource(&res_raw_h2,  "raw_h2");
-  coap_activate_resource(&res_raw_ethanol,  "raw_ethanol");
-  coap_activate_resource(&res_pm1_0,  "pm1_0");
-  coap_activate_resource(&res_pm2_5,  "pm2_5");
-  coap_activate_resource(&res_nc0_5,  "nc0_5");
+  activate_sensor_resources();
+  coap_activate_resource(&res_all,  "all");
   coap_activate_resource(&res_status, "status");
+  coap_activate_resource(&res_sensing, "sensing");
+  coap_activate_resource(&res_notifications, "notifications");
+  coap_activate_resource(&res_observers, "observers");
+#if STAGE_TIMING
+  coap_activate_resource(&res_metrics, "metrics");
+#endif
+#if ENERGEST_CONF_ON
+  coap_activate_resource(&res_energy, "energy");
+#endif
 }
 
-static bool fire_detected(sensor_sim_t *s) {
-    // input vector
-    float features[9];       
-    /* -------- Feature Normalization --------- */
-    features[0] = (s->temperature - MEAN_TEMP) / STD_DEV_TEMP;
-    features[1] = (s->humidity - MEAN_HUMIDITY) / STD_DEV_HUMIDITY;
-    features[2] = ((float)s->tvoc - MEAN_TVOC) / STD_DEV_TVOC;
-    features[3] = ((float)s->raw_h2 - MEAN_RAW_H2) / STD_DEV_RAW_H2;
-    features[4] = ((float)s->raw_ethanol - MEAN_RAW_ETHANOL) / STD_DEV_RAW_ETHANOL;
-    features[5] = (s->pressure - MEAN_PRESSURE) / STD_DEV_PRESSURE;
-    features[6] = ((float)s->pm1_0 - MEAN_PM1_0) / STD_DEV_PM1_0;
-    features[7] = ((float)s->pm2_5 - MEAN_PM2_5) / STD_DEV_PM2_5;
-    features[8] = ((float)s->nc0_5 - MEAN_NC0_5) / STD_DEV_NC0_5;
-    
-    /*for (int i = 0; i < 9; i++) {
-        printf("features[%d] = %f\n", i, features[i]);
-    }*/
-    printf("NN model activation: %p\n", eml_net_activation_function_strs);
-    // This is needed to avoid compiler error (warnings == errors)
-    
-    /* ----------- invoke predictor ----------- */
-    bool is_fire = eml_net_predict(&fire_detector, features, 9) != 0;
-    return is_fire;
+/* Serial console command "sensing <min> <max>": same bounds as a PUT on /sensing, used by the
+*  Cooja energy scenario (Cooja Simulation/energy_sensing_period_sim.csc)
+*/
+static void serial_command(const char *line) {
+  char *end;
+  if(strncmp(line, "sensing ", 8) != 0) {
+    return;
+  }
+  long min = strtol(line + 8, &end, 10);
+  long max = strtol(end, &end, 10);
+  if(sensing_period_set_bounds(&sensing, (int)min, (int)max)) {
+    LOG_INFO("Sensing bounds: %ld-%ld s\n", min, max);
+  } else {
+    LOG_WARN("Invalid sensing bounds: %s\n", line);
+  }
 }
 
 
@@ -102,10 +157,23 @@ PROCESS_THREAD(smart_smoke_detector_process, ev, data)
   /* --------- Activating CoAP Resource ---------- */
   LOG_INFO("Starting Smart Smoke Detector Server\n");
   activate_all_resources();
+#if ENERGEST_CONF_ON
+  energy_init(&res_energy);
+#endif
+#if STATUS_GROUP
+  if(status_group_init() < 0) {
+    PROCESS_EXIT();
+  }
+#endif
   
   /* --- Sensor Simulation: First Measurement ---- */
   LOG_INFO("Starting sensing environment\n");
   simulate_first_measurements(&sensors);
+#if SENSOR_TRACE_REPLAY
+  if(trace_replay_open(SENSOR_TRACE_FILE) < 0) {
+    PROCESS_EXIT();
+  }
+#endif
   update_sensor_resources(&sensors);
 
 #ifdef COOJA
@@ -115,32 +183,69 @@ PROCESS_THREAD(smart_smoke_detector_process, ev, data)
 #endif
 
   /* --- Periodic Sensing Timer setting --- */
-  etimer_set(&e_sensing_timer, CLOCK_SECOND * SENSORS_UPDATE_PERIOD);
+  sensing_period_init(&sensing, SENSORS_UPDATE_PERIOD);
+  schedule_sensing(CLOCK_SECOND * sensing.period);
   
   while(1) {
     PROCESS_WAIT_EVENT();
 	
 	/* ============= New Measurement Periodic Event ============= */
-	if(ev == PROCESS_EVENT_TIMER && data == &e_sensing_timer){
+	if(SENSING_EVENT(ev, data)){
 	
 		LOG_DBG("Sensors value update\n");
+#if VIRTUAL_TIME
+		if(vclock_seconds() >= VIRTUAL_TIME_DURATION) {
+			LOG_INFO("Virtual time: %lu s of scenario done\n", (unsigned long)vclock_seconds());
+			stage_timing_report();
+			continue; // no next measurement
+		}
+#endif
+		STAGE_ITERATION();
+		STAGE_BEGIN(simulate, t_simulate);
+#if SENSOR_TRACE_REPLAY
+		int trace_label;
+		uint32_t trace_utc;
+		clock_time_t row_start = clock_time();
+		if(!trace_replay_next(&sensors, &trace_label, &trace_utc)) {
+			trace_replay_report(&replay);
+			trace_replay_close();
+			STAGE_END(simulate, t_simulate);
+			continue; // end of the trace: sensing timer not set again
+		}
+#else
+#if VIRTUAL_TIME
+		virtual_scenario(vclock_seconds());
+#endif
 		simulate_new_measurements(&sensors,  simulate_fire_ignition, simulate_hazard_condition);
+#endif
+		STAGE_END(simulate, t_simulate);
+		STAGE_BEGIN(update, t_update);
 		update_sensor_resources(&sensors);
+		STAGE_END(update, t_update);
 		
 		
 		unsigned int old_status = status;
 		/* ------------ check scenario 1 (FIRE DETECTED - status 1) ------------*/
 		//  activated if:
-		//		- fast changes are detected (confront current vs 5th (or older avail.) measures)
+		//		- a sustained trend is detected (least-squares slope over the last SENML_TREND_WINDOW measures)
 		//		- status 0 OR 2 (if status=1 another timer will handle it)
 		//		- positive output from AI model fire detection (probability > 0.5)
-		if(fast_change_detected(&sensors, 5)) { 
-			LOG_INFO("Fast Environment Change Detected\n");
+		STAGE_BEGIN(trend, t_trend);
+		bool trend = trend_detected();
+		STAGE_END(trend, t_trend);
+		if(trend) { 
+			LOG_INFO("Environment Trend Detected\n");
 			
+			STAGE_BEGIN(inference, t_inference);
 			bool fire_detec = (bool)fire_detected(&sensors);
+			STAGE_END(inference, t_inference);
 			/* ------ AI model fire detection ------ */
 			if(fire_detec && (status != 1)){
 				LOG_INFO("Fire Detected\n");
+				if(simulate_fire_ignition) {
+					sensing.detection_latency = vclock_seconds() - fire_ignition_time;
+					LOG_INFO("Detection latency: %lu s\n", (unsigned long)sensing.detection_latency);
+				}
 				/* ------- update status resource -------- */
 				status = 1;
 				/* ------ activate water sprinkler ------- */
@@ -204,26 +309,40 @@ PROCESS_THREAD(smart_smoke_detector_process, ev, data)
 		}
 		
 		/* -------- Status CoAP Resource Subscribers Notification -------- */
-		// if status has changed, all subscribers to status resource are notified
+		// if status has changed, all subscribers to status resource are notified (never rate limited)
 		// actuators, acting as subscribers, are operated accordingly
+		STAGE_BEGIN(trigger, t_trigger);
 		if(old_status != status){
+			status_stamp(); // alarm latency origin: measured end to end by the vent
 			res_status.trigger();
 		}
 		
-		/* -------- Sensor CoAP Resources Subscribers Periodic Notification -------- */
-		// at the end of each buffer cycle ONLY
-		if(is_temp_buffer_cycle_complete()) 	   {res_temp.trigger();}
-		if(is_hum_buffer_cycle_complete()) 	   {res_hum.trigger();}
-		if(is_pressure_buffer_cycle_complete())    {res_pressure.trigger();}
-		if(is_tvoc_buffer_cycle_complete()) 	   {res_tvoc.trigger();}
-		if(is_raw_h2_buffer_cycle_complete()) 	   {res_raw_h2.trigger();}
-		if(is_raw_ethanol_buffer_cycle_complete()) {res_raw_ethanol.trigger();}
-		if(is_pm1_0_buffer_cycle_complete()) 	   {res_pm1_0.trigger();}
-		if(is_pm2_5_buffer_cycle_complete()) 	   {res_pm2_5.trigger();}
-		if(is_nc0_5_buffer_cycle_complete()) 	   {res_nc0_5.trigger();}
+		/* -------- Sensor CoAP Resources Subscribers Notification -------- */
+		// each sensor resource by its own policy (lib/notify_policy.h): deadband moved or max_interval
+		// elapsed, or the end of each buffer cycle with the cycle policy
+		// /all pack (one notification per observer): still at the end of each buffer cycle only
+		// rate limited: at most one notification per resource every NOTIFY_MIN_GAP, the rest coalesced
+		if(notify_sensor_observers()) {res_all.trigger();}
+		STAGE_END(trigger, t_trigger);
 		
-		/* ------ Periodic Sensing Timer periodic setting ------ */
-		etimer_set(&e_sensing_timer, CLOCK_SECOND * SENSORS_UPDATE_PERIOD);
+		/* ------ Adaptive Sensing Timer setting ------ */
+		// shortest period while the environment is volatile or an alarm is on, stretched in steady state
+		uint16_t old_period = sensing.period;
+		sensing_period_update(&sensing, trend || pm_rising(&sensors) || (status != 0));
+		if(sensing.period != old_period) {
+			LOG_INFO("Sensing period: %u s\n", sensing.period);
+		}
+#if SENSOR_TRACE_REPLAY
+		trace_replay_score(&replay, trace_label, trace_utc, status, clock_time() - row_start);
+		schedule_sensing(SENSOR_TRACE_PERIOD); // rows at the trace pace, not the sensing one
+#else
+		schedule_sensing(CLOCK_SECOND * sensing.period);
+#endif
+	}
+	
+	/* ============ Serial Console Command ============ */
+	else if(ev == serial_line_event_message) {
+		serial_command((const char *)data);
 	}
 	
 	/* ============ Button Release Event: Hazard/Fire Conditions Simulator ============ */
@@ -232,6 +351,7 @@ PROCESS_THREAD(smart_smoke_detector_process, ev, data)
 		if(btn->press_duration_seconds > BUTTON_PRESS_TIME_TO_FIRE) {
 			simulate_fire_ignition = !simulate_fire_ignition;
 			if(simulate_fire_ignition){
+				fire_ignition_time = vclock_seconds();
 				LOG_DBG("FIRE SIMULATION START \n");
 			} else {
 				LOG_DBG("FIRE SIMULATION END \n");
@@ -0,0 +1,97 @@
+#!/usr/bin/env python3
+"""Benchmark table of the fire detection model variants (lib/fire_model.h).
+
+  python3 tools/fire_model_table.py [--dataset smoke_detection_iot.csv] [--emlearn <dir>]
+                                    [--cc "arm-none-eabi-gcc -mcpu=cortex-m4 -mthumb -Os"] [--size arm-none-eabi-size]
+
+For every variant whose model header exists:
+  - flash and RAM of the model code and data (lib/fire_model.c, fire_features.c, fire_qnet.c),
+    from `size` on objects built with --cc (host cc by default: use the target cross compiler
+    for meaningful numbers)
+  - p50 latency, accuracy and false alarm rate of host/replay-fire on the dataset (on a
+    sensor_sim trace without one, no accuracy)
+Prints a Markdown table; the target cycles column is left for measurements on the board.
+"""
+import argparse
+import os
+import re
+import shlex
+import subprocess
+import sys
+import tempfile
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+# name, make variables, model header
+VARIANTS = [
+    ("net", {"FIRE_MODEL": "net", "FIRE_MODEL_NORM": "runtime"}, "fire_detector.h"),
+    ("net, folded", {"FIRE_MODEL": "net", "FIRE_MODEL_NORM": "folded"}, "fire_detector_folded.h"),
+    ("net, quantized", {"FIRE_MODEL": "net", "FIRE_MODEL_QUANT": "1"}, "fire_detector_q.h"),
+    ("tree", {"FIRE_MODEL": "tree"}, "fire_detector_tree.h"),
+    ("forest", {"FIRE_MODEL": "forest"}, "fire_detector_forest.h"),
+]
+
+DEFINES = {
+    "FIRE_MODEL": {"net": [], "tree": ["-DFIRE_MODEL_KIND=1"], "forest": ["-DFIRE_MODEL_KIND=2"]},
+}
+
+
+def defines(variables):
+    flags = list(DEFINES["FIRE_MODEL"][variables.get("FIRE_MODEL", "net")])
+    if variables.get("FIRE_MODEL_QUANT") == "1":
+        flags.append("-DFIRE_DETECTOR_QUANTIZED=1")
+    if variables.get("FIRE_MODEL_NORM", "folded") == "folded":
+        flags.append("-DFIRE_DETECTOR_FOLDED=1")
+    return flags
+
+
+def footprint(cc, size, emlearn, variables):
+    sources = ["lib/fire_model.c", "lib/fire_features.c", "lib/fire_qnet.c"]
+    flash = ram = 0
+    with tempfile.TemporaryDirectory() as tmp:
+        for source in sources:
+            obj = os.path.join(tmp, os.path.basename(source) + ".o")
+            subprocess.run(shlex.split(cc) + defines(variables) + [
+                "-I" + ROOT, "-I" + os.path.join(ROOT, "host"), "-I" + emlearn,
+                "-c", os.path.join(ROOT, source), "-o", obj], check=True)
+            out = subprocess.run([size, obj], check=True, capture_output=True, text=True).stdout
+            text, data, bss = (int(v) for v in out.splitlines()[1].split()[:3])
+            flash += text + data
+            ram += data + bss
+    return flash, ram
+
+
+def replay(emlearn, variables, dataset):
+    make = ["make", "-s", "-B", "-C", os.path.join(ROOT, "host"), "replay-fire", "EMLEARN_DIR=" + emlearn]
+    subprocess.run(make + ["%s=%s" % kv for kv in variables.items()], check=True)
+    cmd = [os.path.join(ROOT, "host", "replay-fire")] + ([dataset, "3"] if dataset else [])
+    out = subprocess.run(cmd, check=True, capture_output=True, text=True).stdout
+    p50 = re.search(r"p50 (\d+)", out).group(1)
+    accuracy = re.search(r"accuracy ([\d.]+%)", out)
+    false_alarms = re.search(r"false alarms ([\d.]+%)", out)
+    return p50, accuracy.group(1) if accuracy else "-", false_alarms.group(1) if false_alarms else "-"
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    parser.add_argument("--dataset", help="Kaggle smoke detection CSV (accuracy and false alarms)")
+    parser.add_argument("--emlearn", default="/home/iot_ubuntu_intel/.local/lib/python3.10/site-packages/emlearn")
+    parser.add_argument("--cc", default="cc -Os -std=gnu99")
+    parser.add_argument("--size", default="size")
+    args = parser.parse_args()
+    dataset = os.path.abspath(args.dataset) if args.dataset else None
+
+    print("| model | flash (B) | RAM (B) | host p50 (ns) | target cycles | accuracy | false alarms |")
+    print("|---|---:|---:|---:|---:|---:|---:|")
+    for name, variables, header in VARIANTS:
+        if not os.path.exists(os.path.join(ROOT, header)):
+            print("| %s | %s not generated | | | | | |" % (name, header))
+            continue
+        flash, ram = footprint(args.cc, args.size, args.emlearn, variables)
+        p50, accuracy, false_alarms = replay(args.emlearn, variables, dataset)
+        print("| %s | %d | %d | %s | - | %s | %s |" % (name, flash, ram, p50, accuracy, false_alarms))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,101 @@
+#!/usr/bin/env python3
+"""Generate fire_detector_folded.h, the emlearn fire_detector MLP taking raw sensor values.
+
+  python3 tools/fold_fire_detector.py --dataset smoke_detection_iot.csv
+                                      [--model fire_detector.h] [--out fire_detector_folded.h]
+
+The feature normalization x' = (x - MEAN) / STD_DEV (lib/features_norm_constants.h) is folded
+into the first layer:
+  w'[o + i * n_out] = w[o + i * n_out] / STD_DEV[i]
+  b'[o]             = b[o] - sum_i w[o + i * n_out] * MEAN[i] / STD_DEV[i]
+The other layers are shared with fire_detector.h, which the generated header includes.
+The folded and unfolded networks are compared on the dataset rows: the script fails if any
+output differs by more than --tolerance or any decision (output > 0.5) differs.
+"""
+import argparse
+import os
+import sys
+
+from quantize_fire_detector import FEATURE_COLUMNS, float_forward, parse_model, parse_norm_constants, dataset_inputs
+
+
+def fold(layer, means, std_devs):
+    n_out = layer["n_outputs"]
+    weights = list(layer["weights"])
+    biases = list(layer["biases"])
+    for i in range(layer["n_inputs"]):
+        for o in range(n_out):
+            w = weights[o + i * n_out] / std_devs[i]
+            weights[o + i * n_out] = w
+            biases[o] -= w * means[i]
+    return dict(layer, weights=weights, biases=biases)
+
+
+def c_float(v):
+    return "%.9gf" % v if "." in "%.9g" % v or "e" in "%.9g" % v else "%.1ff" % v
+
+
+def c_array(name, values):
+    return "static const float %s[%d] = { %s };\n" % (name, len(values), ", ".join(c_float(v) for v in values))
+
+
+def write_header(path, name, model, layers, source):
+    layer0 = layers[0]
+    out = []
+    out.append("/* Generated by tools/fold_fire_detector.py from %s: do not edit.\n" % source)
+    out.append("*  Feature normalization (lib/features_norm_constants.h) folded into layer 0: raw sensor inputs.\n*/\n")
+    out.append("#include \"%s\"\n" % os.path.basename(model))
+    out.append(c_array("%s_layer_0_biases" % name, layer0["biases"]))
+    out.append(c_array("%s_layer_0_weights" % name, layer0["weights"]))
+    out.append("static const EmlNetLayer %s_layers[%d] = { \n" % (name, len(layers)))
+    rows = ["{ %d, %d, %s_layer_0_weights, %s_layer_0_biases, EmlNetActivation%s }" % (
+        layer0["n_outputs"], layer0["n_inputs"], name, name, layer0["activation"])]
+    for l, layer in enumerate(layers[1:], 1):
+        rows.append("{ %d, %d, fire_detector_layer_%d_weights, fire_detector_layer_%d_biases, EmlNetActivation%s }" % (
+            layer["n_outputs"], layer["n_inputs"], l, l, layer["activation"]))
+    out.append(", \n".join(rows) + " };\n")
+    width = max(layer["n_outputs"] for layer in layers)
+    out.append("static EmlNet %s = { %d, %s_layers, fire_detector_buf1, fire_detector_buf2, %d };\n" % (
+        name, len(layers), name, width))
+    with open(path, "w") as f:
+        f.write("".join(out))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    parser.add_argument("--model", default="fire_detector.h")
+    parser.add_argument("--norm", default="lib/features_norm_constants.h")
+    parser.add_argument("--dataset", required=True, help="Kaggle smoke detection CSV used for the regression check")
+    parser.add_argument("--out", default="fire_detector_folded.h")
+    parser.add_argument("--name", default="fire_detector_folded")
+    parser.add_argument("--tolerance", type=float, default=1e-6)
+    args = parser.parse_args()
+
+    layers = parse_model(args.model)
+    norm = parse_norm_constants(args.norm)
+    means = [norm["MEAN_" + key] for key, _ in FEATURE_COLUMNS]
+    std_devs = [norm["STD_DEV_" + key] for key, _ in FEATURE_COLUMNS]
+    folded = [fold(layers[0], means, std_devs)] + layers[1:]
+
+    # regression check: same outputs on raw inputs, with and without the folding
+    normalized = dataset_inputs(args.dataset, norm)
+    raw = [[x * s + m for x, m, s in zip(row, means, std_devs)] for row in normalized]
+    source = "%s, checked on %s" % (args.model, os.path.basename(args.dataset))
+    worst = 0.0
+    flipped = 0
+    for x in raw:
+        _, reference = float_forward(layers, [(v - m) / s for v, m, s in zip(x, means, std_devs)])
+        _, y = float_forward(folded, x)
+        worst = max(worst, abs(y[0] - reference[0]))
+        flipped += (y[0] > 0.5) != (reference[0] > 0.5)
+    print("%s: max output difference %.3g, %d decisions flipped on %d inputs" % (args.out, worst, flipped, len(raw)))
+    if worst > args.tolerance or flipped:
+        print("folded model differs from %s beyond %g" % (args.model, args.tolerance), file=sys.stderr)
+        return 1
+
+    write_header(args.out, args.name, args.model, folded, source)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,252 @@
+#!/usr/bin/env python3
+"""Generate fire_detector_q.h, an integer version of the emlearn fire_detector MLP.
+
+  python3 tools/quantize_fire_detector.py --dataset smoke_detection_iot.csv
+                                          [--model fire_detector.h] [--out fire_detector_q.h]
+
+Weights become int8 and biases int32, activations int16, every tensor in a power-of-two
+fixed-point format (Q<frac bits>) so that the kernels in lib/fire_qnet.c only need integer
+multiply-accumulates and shifts. The activation formats are calibrated on the dataset rows
+(Kaggle "Smoke Detection Dataset" CSV, normalized with lib/features_norm_constants.h), so that
+its outliers set the input range. The agreement with the float model on the dataset rows is
+printed at the end.
+
+Pure Python, no numpy: the network is small.
+"""
+import argparse
+import csv
+import math
+import re
+import sys
+
+INT8_MAX = 127
+INT16_MAX = 32767
+ACTIVATION_MARGIN = 1.5  # headroom over the calibrated activation range
+
+# model input order of fire_detected() (lib/sensor_table.h feature column) -> dataset columns
+FEATURE_COLUMNS = [
+    ("TEMP", "Temperature[C]"),
+    ("HUMIDITY", "Humidity[%]"),
+    ("TVOC", "TVOC[ppb]"),
+    ("RAW_H2", "Raw H2"),
+    ("RAW_ETHANOL", "Raw Ethanol"),
+    ("PRESSURE", "Pressure[hPa]"),
+    ("PM1_0", "PM1.0"),
+    ("PM2_5", "PM2.5"),
+    ("NC0_5", "NC0.5"),
+]
+LABEL_COLUMN = "Fire Alarm"
+
+
+# ==================== emlearn header parsing ====================
+
+def parse_float_array(text, name):
+    match = re.search(r"static const float %s\[(\d+)\] = \{([^}]*)\};" % re.escape(name), text)
+    if not match:
+        raise ValueError("array %s not found" % name)
+    values = [float(v.strip().rstrip("f")) for v in match.group(2).split(",") if v.strip()]
+    if len(values) != int(match.group(1)):
+        raise ValueError("array %s: %d values, %s declared" % (name, len(values), match.group(1)))
+    return values
+
+
+def parse_model(path, name="fire_detector"):
+    with open(path) as f:
+        text = f.read()
+    table = re.search(r"static const EmlNetLayer %s_layers\[(\d+)\] = \{(.*?)\};" % name, text, re.S)
+    if not table:
+        raise ValueError("layer table %s_layers not found" % name)
+    layers = []
+    for n_out, n_in, weights, biases, activation in re.findall(
+            r"\{\s*(\d+),\s*(\d+),\s*(\w+),\s*(\w+),\s*EmlNetActivation(\w+)\s*\}", table.group(2)):
+        layers.append({
+            "n_outputs": int(n_out),
+            "n_inputs": int(n_in),
+            "weights": parse_float_array(text, weights),
+            "biases": parse_float_array(text, biases),
+            "activation": activation,
+        })
+    if len(layers) != int(table.group(1)):
+        raise ValueError("expected %s layers, parsed %d" % (table.group(1), len(layers)))
+    return layers
+
+
+def parse_norm_constants(path):
+    constants = {}
+    with open(path) as f:
+        for name, value in re.findall(r"#define\s+(\w+)\s+(-?[\d.]+)f?", f.read()):
+            constants[name] = float(value)
+    return constants
+
+
+# ==================== float reference ====================
+
+def layer_forward(layer, x):
+    # emlearn layout: weight of input i to output o at o + i * n_outputs
+    n_out = layer["n_outputs"]
+    w = layer["weights"]
+    out = []
+    for o in range(n_out):
+        s = layer["biases"][o]
+        for i, xi in enumerate(x):
+            s += xi * w[o + i * n_out]
+        out.append(s)
+    return out
+
+
+def activate(layer, z):
+    if layer["activation"] == "Relu":
+        return [max(0.0, v) for v in z]
+    if layer["activation"] == "Logistic":
+        return [1.0 / (1.0 + math.exp(-max(-80.0, min(80.0, v)))) for v in z]
+    if layer["activation"] == "Identity":
+        return z
+    raise ValueError("unsupported activation %s" % layer["activation"])
+
+
+def float_forward(layers, x):
+    # returns the inputs of every layer and the network output
+    inputs = []
+    for layer in layers:
+        inputs.append(x)
+        x = activate(layer, layer_forward(layer, x))
+    return inputs, x
+
+
+# ==================== calibration inputs ====================
+
+def dataset_inputs(path, norm):
+    rows = []
+    with open(path, newline="") as f:
+        for row in csv.DictReader(f):
+            x = []
+            for key, column in FEATURE_COLUMNS:
+                x.append((float(row[column]) - norm["MEAN_" + key]) / norm["STD_DEV_" + key])
+            rows.append(x)
+    return rows
+
+
+# ==================== quantization ====================
+
+def frac_bits_for(max_abs, limit, lo=0, hi=15):
+    # largest power-of-two scale keeping max_abs within limit
+    if max_abs <= 0:
+        return hi
+    return max(lo, min(hi, int(math.floor(math.log2(limit / max_abs)))))
+
+
+def quantize(layers, calibration):
+    # activation range at the input of every layer
+    in_max = [0.0] * len(layers)
+    for x in calibration:
+        inputs, _ = float_forward(layers, x)
+        for l, v in enumerate(inputs):
+            in_max[l] = max(in_max[l], max(abs(e) for e in v))
+
+    act_frac = [frac_bits_for(m * ACTIVATION_MARGIN, INT16_MAX, hi=14) for m in in_max]
+    qlayers = []
+    for l, layer in enumerate(layers):
+        w_frac = frac_bits_for(max(abs(w) for w in layer["weights"]), INT8_MAX, hi=14)
+        acc_frac = w_frac + act_frac[l]
+        last = (l == len(layers) - 1)
+        out_frac = acc_frac if last else act_frac[l + 1]
+        if out_frac > acc_frac:  # kernels only shift right
+            out_frac = acc_frac
+            act_frac[l + 1] = out_frac
+        qlayers.append({
+            "n_outputs": layer["n_outputs"],
+            "n_inputs": layer["n_inputs"],
+            "weights": [max(-INT8_MAX, min(INT8_MAX, int(round(w * (1 << w_frac))))) for w in layer["weights"]],
+            "biases": [int(round(b * (1 << acc_frac))) for b in layer["biases"]],
+            "shift": acc_frac - out_frac,
+            "activation": layer["activation"],
+            "w_frac": w_frac,
+        })
+    return qlayers, act_frac[0]
+
+
+def saturate16(v):
+    return max(-INT16_MAX - 1, min(INT16_MAX, v))
+
+
+def int_forward(qlayers, input_frac, x):
+    # bit-exact model of fire_qnet_predict (lib/fire_qnet.c), returns the last accumulator
+    a = [saturate16(int(math.floor(v * (1 << input_frac) + 0.5))) for v in x]
+    for l, q in enumerate(qlayers):
+        n_out = q["n_outputs"]
+        acc = []
+        for o in range(n_out):
+            s = q["biases"][o]
+            for i, ai in enumerate(a):
+                s += ai * q["weights"][o + i * n_out]
+            acc.append(s)
+        if l == len(qlayers) - 1:
+            return acc
+        half = (1 << (q["shift"] - 1)) if q["shift"] > 0 else 0
+        a = [saturate16((max(0, s) + half) >> q["shift"]) if q["activation"] == "Relu"
+             else saturate16((s + half) >> q["shift"]) for s in acc]
+
+
+# ==================== header output ====================
+
+def c_array(ctype, name, values, per_line=16):
+    lines = []
+    for i in range(0, len(values), per_line):
+        lines.append("  " + ", ".join(str(v) for v in values[i:i + per_line]))
+    return "static const %s %s[%d] = {\n%s\n};\n" % (ctype, name, len(values), ",\n".join(lines))
+
+
+def write_header(path, name, qlayers, input_frac, source):
+    activations = {"Relu": "FIRE_QNET_RELU", "Identity": "FIRE_QNET_IDENTITY", "Logistic": "FIRE_QNET_LOGISTIC"}
+    width = max(q["n_outputs"] for q in qlayers)
+    out = []
+    out.append("/* Generated by tools/quantize_fire_detector.py from %s: do not edit.\n" % source)
+    out.append("*  int8 weights, int32 biases, int16 activations (input Q%d), see lib/fire_qnet.h\n*/\n" % input_frac)
+    out.append("#include \"lib/fire_qnet.h\"\n\n")
+    for l, q in enumerate(qlayers):
+        out.append("// layer %d: %d -> %d, weights Q%d, output shift %d\n" % (l, q["n_inputs"], q["n_outputs"], q["w_frac"], q["shift"]))
+        out.append(c_array("int32_t", "%s_layer_%d_biases" % (name, l), q["biases"]))
+        out.append(c_array("int8_t", "%s_layer_%d_weights" % (name, l), q["weights"]))
+        out.append("\n")
+    out.append("static const fire_qnet_layer %s_layers[%d] = {\n" % (name, len(qlayers)))
+    for l, q in enumerate(qlayers):
+        out.append("  { %d, %d, %s_layer_%d_weights, %s_layer_%d_biases, %d, %s },\n" % (
+            q["n_outputs"], q["n_inputs"], name, l, name, l, q["shift"], activations[q["activation"]]))
+    out.append("};\n")
+    out.append("static int16_t %s_buf1[%d];\n" % (name, width))
+    out.append("static int16_t %s_buf2[%d];\n" % (name, width))
+    out.append("static fire_qnet %s = { %d, %s_layers, %d, %s_buf1, %s_buf2 };\n" % (
+        name, len(qlayers), name, input_frac, name, name))
+    with open(path, "w") as f:
+        f.write("".join(out))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    parser.add_argument("--model", default="fire_detector.h")
+    parser.add_argument("--norm", default="lib/features_norm_constants.h")
+    parser.add_argument("--dataset", required=True, help="Kaggle smoke detection CSV used for calibration")
+    parser.add_argument("--out", default="fire_detector_q.h")
+    parser.add_argument("--name", default="fire_detector_q")
+    args = parser.parse_args()
+
+    layers = parse_model(args.model)
+    calibration = dataset_inputs(args.dataset, parse_norm_constants(args.norm))
+    source = "%s, calibrated on %s" % (args.model, args.dataset)
+
+    qlayers, input_frac = quantize(layers, calibration)
+    write_header(args.out, args.name, qlayers, input_frac, source)
+
+    # agreement of the decisions: float logistic > 0.5 vs sign of the integer accumulator
+    agree = 0
+    for x in calibration:
+        _, y = float_forward(layers, x)
+        acc = int_forward(qlayers, input_frac, x)
+        agree += (y[0] > 0.5) == (acc[0] > 0)
+    print("%s: %d layers, input Q%d, agreement with the float model %d/%d (%.2f%%)" % (
+        args.out, len(qlayers), input_frac, agree, len(calibration), 100.0 * agree / len(calibration)))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,94 @@
+#!/usr/bin/env python3
+"""Train the decision tree and random forest fire detectors and convert them with emlearn.
+
+  python3 tools/train_fire_models.py --dataset smoke_detection_iot.csv
+                                     [--tree fire_detector_tree.h] [--forest fire_detector_forest.h]
+
+Inputs are the raw sensed values in the model input order of fire_detected() (trees split on
+thresholds, no normalization needed), target the "Fire Alarm" column. Particulate matter
+columns are rounded as the firmware senses them (int fields of sensor_sim_t). The held-out
+accuracy and false alarm rate of every model are printed, with its size in nodes; the
+generated headers define <name>_predict(features, n_features), see lib/fire_model.c.
+
+Needs scikit-learn and emlearn (pip install scikit-learn emlearn).
+"""
+import argparse
+import csv
+import sys
+
+from quantize_fire_detector import FEATURE_COLUMNS, LABEL_COLUMN
+
+INT_COLUMNS = {"TVOC[ppb]", "Raw H2", "Raw Ethanol", "PM1.0", "PM2.5", "NC0.5"}
+
+
+def load_dataset(path):
+    features, labels = [], []
+    with open(path, newline="") as f:
+        for row in csv.DictReader(f):
+            x = []
+            for _, column in FEATURE_COLUMNS:
+                value = float(row[column])
+                x.append(float(round(value)) if column in INT_COLUMNS else value)
+            features.append(x)
+            labels.append(int(row[LABEL_COLUMN]))
+    return features, labels
+
+
+def evaluate(model, x_test, y_test):
+    predicted = model.predict(x_test)
+    fp = sum(1 for p, y in zip(predicted, y_test) if p == 1 and y == 0)
+    tn = sum(1 for p, y in zip(predicted, y_test) if p == 0 and y == 0)
+    accuracy = sum(1 for p, y in zip(predicted, y_test) if p == y) / len(y_test)
+    return accuracy, (fp / (fp + tn)) if (fp + tn) else 0.0
+
+
+def node_count(model):
+    if hasattr(model, "estimators_"):
+        return sum(e.tree_.node_count for e in model.estimators_)
+    return model.tree_.node_count
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    parser.add_argument("--dataset", required=True, help="Kaggle smoke detection CSV")
+    parser.add_argument("--tree", default="fire_detector_tree.h")
+    parser.add_argument("--forest", default="fire_detector_forest.h")
+    parser.add_argument("--tree-depth", type=int, default=8)
+    parser.add_argument("--forest-trees", type=int, default=10)
+    parser.add_argument("--forest-depth", type=int, default=8)
+    parser.add_argument("--min-samples-leaf", type=int, default=10)
+    parser.add_argument("--seed", type=int, default=42)
+    args = parser.parse_args()
+
+    try:
+        import emlearn
+        from sklearn.ensemble import RandomForestClassifier
+        from sklearn.model_selection import train_test_split
+        from sklearn.tree import DecisionTreeClassifier
+    except ImportError as e:
+        print("%s: pip install scikit-learn emlearn" % e, file=sys.stderr)
+        return 1
+
+    features, labels = load_dataset(args.dataset)
+    x_train, x_test, y_train, y_test = train_test_split(
+        features, labels, test_size=0.2, stratify=labels, random_state=args.seed)
+
+    models = [
+        (args.tree, "fire_detector_tree",
+         DecisionTreeClassifier(max_depth=args.tree_depth, min_samples_leaf=args.min_samples_leaf,
+                                random_state=args.seed)),
+        (args.forest, "fire_detector_forest",
+         RandomForestClassifier(n_estimators=args.forest_trees, max_depth=args.forest_depth,
+                                min_samples_leaf=args.min_samples_leaf, random_state=args.seed)),
+    ]
+    for path, name, model in models:
+        model.fit(x_train, y_train)
+        accuracy, false_alarms = evaluate(model, x_test, y_test)
+        emlearn.convert(model, method="inline").save(file=path, name=name)
+        print("%s: %d nodes, held-out accuracy %.2f%%, false alarms %.2f%%" % (
+            path, node_count(model), 100.0 * accuracy, 100.0 * false_alarms))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
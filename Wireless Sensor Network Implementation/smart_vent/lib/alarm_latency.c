@@ -0,0 +1,66 @@
+#include "lib/alarm_latency.h"
+#include "contiki.h"
+
+alarm_latency_t alarm_latency;
+const uint32_t alarm_latency_bounds[ALARM_LATENCY_BUCKETS - 1] = ALARM_LATENCY_BOUNDS;
+
+uint32_t alarm_latency_now(void) {
+  return (uint32_t)((uint64_t)clock_time() * 1000 / CLOCK_SECOND);
+}
+
+void alarm_latency_sync(uint32_t request_ms, uint32_t response_ms, uint32_t remote_ms, uint16_t seq) {
+  alarm_latency.rtt = response_ms - request_ms;
+  alarm_latency.offset = (int32_t)(remote_ms - (request_ms + alarm_latency.rtt / 2));
+  alarm_latency.synced = true;
+  // the current status is not a change: later sequence numbers are
+  alarm_latency.last_seq = seq;
+  alarm_latency.seq_valid = true;
+}
+
+bool alarm_latency_record(uint16_t seq, uint32_t origin_ms, uint32_t actuated_ms) {
+  alarm_latency_t *l = &alarm_latency;
+  if(l->seq_valid) {
+    uint16_t gap = (uint16_t)(seq - l->last_seq);
+    if(gap == 0 || gap > UINT16_MAX / 2) {
+      return false; // duplicate or older notification
+    }
+    l->lost += gap - 1;
+  }
+  l->last_seq = seq;
+  l->seq_valid = true;
+  if(!l->synced) {
+    return false;
+  }
+
+  // origin in the vent clock: detector time minus the offset
+  int32_t delay = (int32_t)(actuated_ms - (origin_ms - (uint32_t)l->offset));
+  uint32_t ms = (delay < 0) ? 0 : (uint32_t)delay; // within the sync uncertainty
+
+  int b = 0;
+  while(b < ALARM_LATENCY_BUCKETS - 1 && ms > alarm_latency_bounds[b]) {
+    b++;
+  }
+  l->buckets[b]++;
+  if(l->count == 0 || ms < l->min) l->min = ms;
+  if(ms > l->max) l->max = ms;
+  l->count++;
+  l->sum += ms;
+  l->last = ms;
+  return true;
+}
+
+uint32_t alarm_latency_percentile(unsigned int p) {
+  const alarm_latency_t *l = &alarm_latency;
+  if(l->count == 0) {
+    return 0;
+  }
+  uint32_t rank = (uint32_t)(((uint64_t)l->count * p + 99) / 100); // nearest rank
+  uint32_t seen = 0;
+  for(int b = 0; b < ALARM_LATENCY_BUCKETS - 1; b++) {
+    seen += l->buckets[b];
+    if(seen >= rank) {
+      return (alarm_latency_bounds[b] < l->max) ? alarm_latency_bounds[b] : l->max;
+    }
+  }
+  return l->max;
+}
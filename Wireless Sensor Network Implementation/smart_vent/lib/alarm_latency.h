@@ -0,0 +1,51 @@
+#ifndef ALARM_LATENCY_H
+#define ALARM_LATENCY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* End-to-end alarm latency: from the status change on the Smart Smoke Detector (origin timestamp
+*  "ts" of the /status payload, detector clock) to the vent actuation here (vent clock), in ms.
+*  The two clocks are aligned NTP-style on the observe registration: the detector stamps its
+*  response ("now"), assumed halfway through the request round trip, so every delay carries an
+*  uncertainty of +-rtt/2. Delays are kept in a fixed-bucket histogram, p50/p99 are read from it.
+*/
+
+// bucket upper bounds (ms), the last bucket takes everything above
+#define ALARM_LATENCY_BOUNDS { 10, 20, 50, 100, 200, 500, 1000, 2000, 5000 }
+#define ALARM_LATENCY_BUCKETS 10
+
+typedef struct {
+  uint32_t count;
+  uint32_t sum;
+  uint32_t min;
+  uint32_t max;
+  uint32_t last;        // last delay
+  uint16_t last_seq;    // status sequence number of the last change seen
+  uint32_t lost;        // status changes never received (sequence gaps)
+  uint32_t buckets[ALARM_LATENCY_BUCKETS];
+
+  bool synced;
+  bool seq_valid;
+  int32_t offset;       // detector clock - vent clock, ms
+  uint32_t rtt;         // registration round trip, ms
+} alarm_latency_t;
+
+extern alarm_latency_t alarm_latency;
+extern const uint32_t alarm_latency_bounds[ALARM_LATENCY_BUCKETS - 1];
+
+// vent clock, ms
+uint32_t alarm_latency_now(void);
+
+// observe registration: request sent at request_ms, response (detector clock remote_ms) at response_ms
+void alarm_latency_sync(uint32_t request_ms, uint32_t response_ms, uint32_t remote_ms, uint16_t seq);
+
+/* Status change seq, originated at origin_ms (detector clock), actuated at actuated_ms (vent clock).
+*  Returns false if it is not a new change (already seen) or the clocks are not aligned yet.
+*/
+bool alarm_latency_record(uint16_t seq, uint32_t origin_ms, uint32_t actuated_ms);
+
+// upper bound of the bucket holding the p-th percentile (max for the last bucket), 0 if empty
+uint32_t alarm_latency_percentile(unsigned int p);
+
+#endif // ALARM_LATENCY_H
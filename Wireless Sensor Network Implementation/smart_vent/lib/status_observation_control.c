@@ -1,9 +1,19 @@
 // reference: https://github.com/contiki-ng/contiki-ng/blob/develop/examples/coap/coap-example-client/coap-example-observe-client.c
 #include "lib/status_observation_control.h"
 #include "lib/ventilation_control.h"
+#include "lib/alarm_latency.h"
+#include "energy.h"
+#include "lib/network_config.h"
 #include "coap-engine.h"
 #include "coap.h"
+#if STATUS_GROUP
+#include "coap-callback-api.h"
+#include "net/ipv6/uip-ds6.h"
+#include "net/ipv6/uiplib.h"
+#endif
 #include "sys/log.h"
+#include <string.h> // for memcpy
+#include <stdbool.h>
 #include "dev/leds.h"
 
 #define LOG_MODULE "SV-Obs-C"
@@ -14,16 +24,119 @@ static char *obs_res_status_url = "/status";
 
 /* ---------- Network Data Structure ---------- */
 static coap_endpoint_t ssd_server_ep;
+#if !STATUS_GROUP
 static coap_observee_t *obs;
+#endif
+
+/* ---------- Alarm Latency ---------- */
+extern coap_resource_t res_latency;
+static uint32_t registration_ms; // vent clock when the observe (or group sync) request was sent
 
 int observation_init(const char *server_ep_str){
   if(coap_endpoint_parse(server_ep_str, strlen(server_ep_str), &ssd_server_ep) == 0) {
     LOG_ERR("Failed to parse endpoint: %s\n", server_ep_str);
     return -1;
   }
+#if STATUS_GROUP
+  uip_ipaddr_t group_addr;
+  if(uiplib_ipaddrconv(STATUS_GROUP_ADDR, &group_addr) == 0 || uip_ds6_maddr_add(&group_addr) == NULL) {
+    LOG_ERR("Failed to join status group: %s\n", STATUS_GROUP_ADDR);
+    return -1;
+  }
+#endif
   return 0;
 }
 
+/*
+ * Apply a status payload (notification, registration response or group message):
+ * set the vents, then align the clocks (registration) or record the alarm latency
+ */
+static void apply_status(const uint8_t *payload, int len, bool registration)
+{
+  uint32_t received_ms = alarm_latency_now();
+  char json[MAX_PAYLOAD_LEN];
+  if(len >= (int)sizeof(json)) {
+    len = sizeof(json) - 1;
+  }
+  memcpy(json, payload, len);
+  json[len] = '\0';
+
+  unsigned int status_value = 0;
+  // Simple JSON parsing (assumes {"status": %u, ..., "seq": %u, "ts": %lu, "now": %lu})
+  const char *status_str = strstr(json, "\"status\":"); //strstr find first occurrency of parameter
+  if(status_str != NULL) {
+    sscanf(status_str, "\"status\": %u", &status_value);
+    set_vent_by_status(status_value);
+  } else { LOG_WARN("status value not properly received\n"); return; }
+
+  /* ------ end-to-end alarm latency (lib/alarm_latency.h) ------ */
+  unsigned int seq;
+  unsigned long ts, now;
+  const char *seq_str = strstr(json, "\"seq\":");
+  if(seq_str == NULL || sscanf(seq_str, "\"seq\": %u, \"ts\": %lu, \"now\": %lu", &seq, &ts, &now) != 3) {
+    return; // detector without status stamping
+  }
+  if(registration) {
+    // registration response: align the clocks, the current status is not a change
+    alarm_latency_sync(registration_ms, received_ms, (uint32_t)now, (uint16_t)seq);
+    LOG_INFO("Clock offset to detector: %ld ms (rtt %lu ms)\n",
+             (long)alarm_latency.offset, (unsigned long)alarm_latency.rtt);
+  } else if(alarm_latency_record((uint16_t)seq, (uint32_t)ts, alarm_latency_now())) {
+    LOG_INFO("Alarm latency: %lu ms (status seq %u)\n", (unsigned long)alarm_latency.last, seq);
+    res_latency.trigger();
+  }
+}
+
+// apply_status accounted to the actuation Energest type (common/energy.h)
+static void process_status(const uint8_t *payload, int len, bool registration)
+{
+  ENERGY_APP_ON(ACTUATION);
+  apply_status(payload, len, registration);
+  ENERGY_APP_OFF(ACTUATION);
+}
+
+#if STATUS_GROUP
+/* ---------- Status Group ---------- */
+static bool group_member; // status group messages applied
+static coap_callback_request_state_t sync_state;
+static coap_message_t sync_request[1];
+
+/*
+ * Handle the response to the GET /status sent when joining: current status and clock alignment
+ */
+static void status_sync_callback(coap_callback_request_state_t *callback_state)
+{
+  coap_request_state_t *state = &callback_state->state;
+  if(state->status == COAP_REQUEST_STATUS_RESPONSE && state->response != NULL) {
+    const uint8_t *payload = NULL;
+    int len = coap_get_payload(state->response, &payload);
+    if(payload != NULL) {
+      process_status(payload, len, true);
+    }
+  } else if(state->status == COAP_REQUEST_STATUS_TIMEOUT) {
+    LOG_WARN("No status from the detector: alarm latency not measured\n");
+  }
+}
+
+void status_group_received(const uint8_t *payload, int len){
+  if(group_member && payload != NULL) {
+    LOG_DBG("--> Status from group %s\n", STATUS_GROUP_ADDR);
+    process_status(payload, len, false);
+  }
+}
+
+static void join_status_group(void){
+  LOG_INFO("Joining status group: %s\n", STATUS_GROUP_ADDR);
+  group_member = true;
+  // current status and clock alignment from the detector
+  coap_init_message(sync_request, COAP_TYPE_CON, COAP_GET, 0);
+  coap_set_header_uri_path(sync_request, obs_res_status_url);
+  registration_ms = alarm_latency_now();
+  coap_send_request(&sync_state, &ssd_server_ep, sync_request, status_sync_callback);
+}
+#endif
+
+#if !STATUS_GROUP
 /*
  * Handle the response to the observe request and the following notifications
  */
@@ -65,42 +178,55 @@ static void status_notification_callback(coap_observee_t *obs, void *notificatio
   }
   LOG_DBG("--> Processing new status information\n");
   if((flag == NOTIFICATION_OK || flag == OBSERVE_OK) && payload != NULL) {
-    
-    unsigned int status_value = 0;
-    // Simple JSON parsing (assumes {"status": %u})
-    const char *status_str = strstr((const char *)payload, "\"status\":"); //strstr find first occurrency of parameter
-    if(status_str != NULL) {
-      sscanf(status_str, "\"status\": %u", &status_value);
-      set_vent_by_status(status_value);
-    } else { LOG_WARN("status value not properly received\n");}
+    process_status(payload, len, flag == OBSERVE_OK);
   }
 }
+#endif
+
+static void alarm_system_on(void){
+#ifdef COOJA
+  leds_on(LEDS_NUM_TO_MASK(LEDS_GREEN));
+#else
+  leds_on(LEDS_BLUE);
+#endif
+}
 
 void toggle_observation(void){
-  if(obs) {
+  if(is_observing()) {
+#if STATUS_GROUP
+    LOG_INFO("Leaving status group\n");
+    group_member = false;
+#else
     LOG_INFO("Stopping observation\n");
     coap_obs_remove_observee(obs);
     obs = NULL;
+#endif
     // set normal status to shutdown all vents
     set_vent_by_status((int) NORMAL_STATUS);
     // switch off alarm system
     leds_off(LEDS_ALL);
   } else {
+#if STATUS_GROUP
+    join_status_group();
+    alarm_system_on();
+#else
     LOG_INFO("Starting observation of resource: %s\n", obs_res_status_url);
+    registration_ms = alarm_latency_now();
     obs = coap_obs_request_registration(&ssd_server_ep, obs_res_status_url, status_notification_callback, NULL);
     if(!obs) {
       printf("Observation request failed\n");
     } else {
-#ifdef COOJA
-    leds_on(LEDS_NUM_TO_MASK(LEDS_GREEN));
-#else
-    leds_on(LEDS_BLUE);
-#endif    
+      alarm_system_on();
     }
+#endif
   }
 }
 
 int is_observing(void){
+#if STATUS_GROUP
+  return group_member;
+#else
   return obs != NULL;
+#endif
 }
 
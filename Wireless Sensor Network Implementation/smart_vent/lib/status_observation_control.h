@@ -3,6 +3,18 @@
 
 #include "coap-engine.h"
 
+/* Status group (make STATUS_GROUP=1): instead of observing /status, the vent joins the
+*  site-local multicast group the detector sends its status changes to (CoAP group
+*  communication, RFC 7252 section 8), received by res_status_group. Joining also GETs
+*  /status once for the current status and the alarm latency clock alignment.
+*/
+#ifndef STATUS_GROUP
+#define STATUS_GROUP 0
+#endif
+#ifndef STATUS_GROUP_ADDR
+#define STATUS_GROUP_ADDR "ff05::fd" // All CoAP Nodes, site-local scope (RFC 7252 section 12.8)
+#endif
+
 #define MODE_ON 1
 #define MODE_OFF 0
 
@@ -12,4 +24,9 @@ void toggle_observation(void);
 
 int is_observing(void);
 
+#if STATUS_GROUP
+// status payload sent by the detector to the group
+void status_group_received(const uint8_t *payload, int len);
+#endif
+
 #endif /* OBSERVATION_CONTROL_H_ */
@@ -7,4 +7,15 @@
 
 #define REST_MAX_CHUNK_SIZE 256
 
+// energy accounting (common/energy.h): Energest with the vent actuation as a type of its own
+#define ENERGEST_CONF_ON 1
+#define ENERGEST_CONF_ADDITIONS ENERGEST_TYPE_ACTUATION
+#define ENERGY_APP_TABLE(X) \
+  X(actuation, ACTUATION) /* status payload parsing and vent control */
+
+// status group (make STATUS_GROUP=1): multicast forwarding independent of the RPL mode
+#if STATUS_GROUP
+#define UIP_MCAST6_CONF_ENGINE UIP_MCAST6_ENGINE_MPL
+#endif
+
 #endif /* PROJECT_CONF_H_ */
@@ -0,0 +1,40 @@
+#include "contiki.h"
+#include "coap-engine.h"
+#include "energy.h"
+#include "lib/network_config.h" // for senML constants
+#include <stdio.h>
+
+#if ENERGEST_CONF_ON
+static void res_get_handler(coap_message_t *request, coap_message_t *response,
+                            uint8_t *buffer, uint16_t preferred_size, int32_t *offset);
+static void res_event_handler(void);
+
+/* Energy of the last ENERGY_REPORT_PERIOD window (common/energy.h): notified after every report */
+EVENT_RESOURCE(res_energy,
+               "title=\"Energy per subsystem\";rt=\"energy\";obs",
+               res_get_handler,
+               NULL,
+               NULL,
+               NULL,
+               res_event_handler);
+
+static void res_event_handler(void) {
+  coap_notify_observers(&res_energy);
+}
+
+static void res_get_handler(coap_message_t *request, coap_message_t *response,
+                            uint8_t *buffer, uint16_t preferred_size, int32_t *offset) {
+  int len = snprintf((char *)buffer, preferred_size, "{\"bn\":\"%senergy\",\"n\":%lu,",
+                     BASE_NAME, (unsigned long)energy_last_window()->reports);
+  if(len > 0 && len < preferred_size) {
+    len += energy_serialize((char *)buffer + len, preferred_size - len);
+  }
+  if(len < 0 || len + 1 >= preferred_size) {
+    coap_set_status_code(response, INTERNAL_SERVER_ERROR_5_00);
+    return;
+  }
+  buffer[len++] = '}';
+  coap_set_header_content_format(response, APPLICATION_JSON);
+  coap_set_payload(response, buffer, len);
+}
+#endif
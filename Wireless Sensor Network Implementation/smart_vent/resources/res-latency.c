@@ -0,0 +1,47 @@
+#include "contiki.h"
+#include "coap-engine.h"
+#include "lib/alarm_latency.h"
+#include "lib/network_config.h" // for senML constants
+#include <stdio.h>
+
+static void res_get_handler(coap_message_t *request, coap_message_t *response,
+                            uint8_t *buffer, uint16_t preferred_size, int32_t *offset);
+static void res_event_handler(void);
+
+/* Alarm latency histogram (lib/alarm_latency.h), ms: notified after every status change actuated */
+EVENT_RESOURCE(res_latency,
+               "title=\"Alarm latency (status change to vent actuation), ms\";rt=\"latency\";obs",
+               res_get_handler,
+               NULL,
+               NULL,
+               NULL,
+               res_event_handler);
+
+static void res_event_handler(void) {
+  coap_notify_observers(&res_latency);
+}
+
+static void res_get_handler(coap_message_t *request, coap_message_t *response,
+                            uint8_t *buffer, uint16_t preferred_size, int32_t *offset) {
+  const alarm_latency_t *l = &alarm_latency;
+  int len = snprintf((char *)buffer, preferred_size,
+                     "{\"bn\":\"%slatency\",\"bu\":\"ms\",\"bt\":%lu,\"seq\":%u,\"v\":%lu,\"n\":%lu,"
+                     "\"min\":%lu,\"avg\":%lu,\"p50\":%lu,\"p99\":%lu,\"max\":%lu,\"lost\":%lu,\"rtt\":%lu,\"hist\":[",
+                     BASE_NAME, (unsigned long)clock_seconds(), l->last_seq, (unsigned long)l->last,
+                     (unsigned long)l->count, (unsigned long)l->min,
+                     l->count ? (unsigned long)(l->sum / l->count) : 0UL,
+                     (unsigned long)alarm_latency_percentile(50), (unsigned long)alarm_latency_percentile(99),
+                     (unsigned long)l->max, (unsigned long)l->lost, (unsigned long)l->rtt);
+  for(int b = 0; b < ALARM_LATENCY_BUCKETS && len > 0 && len < preferred_size; b++) {
+    len += snprintf((char *)buffer + len, preferred_size - len, "%s%lu", b ? "," : "", (unsigned long)l->buckets[b]);
+  }
+  if(len > 0 && len < preferred_size) {
+    len += snprintf((char *)buffer + len, preferred_size - len, "]}");
+  }
+  if(len < 0 || len >= preferred_size) {
+    coap_set_status_code(response, INTERNAL_SERVER_ERROR_5_00);
+    return;
+  }
+  coap_set_header_content_format(response, APPLICATION_JSON);
+  coap_set_payload(response, buffer, len);
+}
@@ -0,0 +1,37 @@
+#include "contiki.h"
+#include "coap-engine.h"
+#include "lib/status_observation_control.h"
+
+#if STATUS_GROUP
+#include "coap-separate.h"
+
+/* Log configuration */
+#include "sys/log.h"
+#define LOG_MODULE "res_group"
+#define LOG_LEVEL LOG_LEVEL_APP
+
+
+static void res_put_handler(coap_message_t *request, coap_message_t *response, uint8_t *buffer, uint16_t preferred_size, int32_t *offset);
+
+/* Status changes sent by the detector to the status group (NON PUT to STATUS_GROUP_ADDR) */
+RESOURCE(res_status_group,
+         "title=\"Status group: PUT status payload (multicast)\";rt=\"Control\"",
+         NULL,
+         NULL,
+         res_put_handler,
+         NULL);
+
+
+static void res_put_handler(coap_message_t *request, coap_message_t *response, uint8_t *buffer, uint16_t preferred_size, int32_t *offset)
+{
+  static coap_separate_t no_response;
+  const uint8_t *payload = NULL;
+  int len = coap_get_payload(request, &payload);
+
+  LOG_DBG("Received group status\n");
+  status_group_received(payload, len);
+
+  // no response to a multicast request (RFC 7252 section 8.1): one per vent would undo the fan-out
+  coap_separate_accept(request, &no_response);
+}
+#endif
@@ -7,6 +7,7 @@
 #include "lib/network_config.h"
 #include "lib/ventilation_control.h"
 #include "lib/status_observation_control.h"
+#include "energy.h"
 #include "sys/etimer.h"
 #include "dev/button-hal.h"
 
@@ -19,6 +20,13 @@
 /* ---------- Exposed CoAP Resources ---------- */
 extern coap_resource_t  res_vent;
 extern coap_resource_t  res_obs_status;
+extern coap_resource_t  res_latency;
+#if STATUS_GROUP
+extern coap_resource_t  res_status_group;
+#endif
+#if ENERGEST_CONF_ON
+extern coap_resource_t  res_energy;
+#endif
 
 
 PROCESS(smart_vent_process, "Smart Vent");
@@ -33,6 +41,14 @@ PROCESS_THREAD(smart_vent_process, ev, data) {
   LOG_INFO("Starting Smart Vent Server\n");
   coap_activate_resource(&res_vent,  "vent");
   coap_activate_resource(&res_obs_status,  "obs_status");
+  coap_activate_resource(&res_latency,  "latency");
+#if STATUS_GROUP
+  coap_activate_resource(&res_status_group,  "status");
+#endif
+#if ENERGEST_CONF_ON
+  coap_activate_resource(&res_energy,  "energy");
+  energy_init(&res_energy);
+#endif
   
   if(observation_init(SSD_SERVER_EP) != 0) {
     PROCESS_EXIT();